@@ -0,0 +1,59 @@
+#shader vertex
+#version 330 core
+
+layout(location = 0) in vec4 position;
+layout(location = 1) in vec2 texCoord;
+layout(location = 2) in vec4 color;
+layout(location = 3) in float texIndex;
+
+out vec2 v_TexCoord;
+out vec4 v_Color;
+flat out int v_TexIndex;
+
+uniform mat4 u_ViewProjection; // Quads are already in world space, so no model matrix
+
+void main() {
+    gl_Position = u_ViewProjection * position;
+    v_TexCoord = texCoord;
+    v_Color = color;
+    v_TexIndex = int(texIndex);
+};
+
+#shader fragment
+#version 330 core
+
+layout(location = 0) out vec4 color;
+
+in vec2 v_TexCoord;
+in vec4 v_Color;
+flat in int v_TexIndex;
+
+uniform sampler2D u_Textures[16];
+
+// GLSL 330 only allows indexing sampler arrays with constant expressions, so
+// select the slot with a switch instead of u_Textures[v_TexIndex]
+vec4 SampleTexture(int index, vec2 texCoord) {
+    switch (index) {
+        case 0: return texture(u_Textures[0], texCoord);
+        case 1: return texture(u_Textures[1], texCoord);
+        case 2: return texture(u_Textures[2], texCoord);
+        case 3: return texture(u_Textures[3], texCoord);
+        case 4: return texture(u_Textures[4], texCoord);
+        case 5: return texture(u_Textures[5], texCoord);
+        case 6: return texture(u_Textures[6], texCoord);
+        case 7: return texture(u_Textures[7], texCoord);
+        case 8: return texture(u_Textures[8], texCoord);
+        case 9: return texture(u_Textures[9], texCoord);
+        case 10: return texture(u_Textures[10], texCoord);
+        case 11: return texture(u_Textures[11], texCoord);
+        case 12: return texture(u_Textures[12], texCoord);
+        case 13: return texture(u_Textures[13], texCoord);
+        case 14: return texture(u_Textures[14], texCoord);
+        case 15: return texture(u_Textures[15], texCoord);
+    }
+    return vec4(1.0);
+}
+
+void main() {
+    color = SampleTexture(v_TexIndex, v_TexCoord) * v_Color;
+};
@@ -0,0 +1,36 @@
+#shader vertex
+#version 330 core
+
+// Per vertex, from the shared unit quad
+layout(location = 0) in vec4 position;
+layout(location = 1) in vec2 texCoord;
+
+// Per instance, divisor 1. A mat4 attribute takes four consecutive locations
+layout(location = 2) in mat4 model;
+layout(location = 6) in vec4 texRect; // xy = offset, zw = scale
+layout(location = 7) in vec4 tint;
+
+out vec2 v_TexCoord;
+out vec4 v_Tint;
+
+uniform mat4 u_ViewProjection;
+
+void main() {
+    gl_Position = u_ViewProjection * model * position;
+    v_TexCoord = texRect.xy + texCoord * texRect.zw;
+    v_Tint = tint;
+};
+
+#shader fragment
+#version 330 core
+
+layout(location = 0) out vec4 color;
+
+in vec2 v_TexCoord;
+in vec4 v_Tint;
+
+uniform sampler2D u_Texture;
+
+void main() {
+    color = texture(u_Texture, v_TexCoord) * v_Tint;
+};
@@ -0,0 +1,31 @@
+#shader vertex
+#version 330 core
+
+// Per vertex, from whichever mesh the draw command points at
+layout(location = 0) in vec2 position;
+
+// Per instance, divisor 1. Each draw command's BaseInstance selects its entry.
+layout(location = 1) in vec4 transform; // xy = offset, z = rotation, w = scale
+layout(location = 2) in vec4 tint;
+
+out vec4 v_Tint;
+
+uniform mat4 u_ViewProjection;
+
+void main() {
+    float c = cos(transform.z), s = sin(transform.z);
+    vec2 world = mat2(c, s, -s, c) * position * transform.w + transform.xy;
+    gl_Position = u_ViewProjection * vec4(world, 0.0, 1.0);
+    v_Tint = tint;
+};
+
+#shader fragment
+#version 330 core
+
+layout(location = 0) out vec4 color;
+
+in vec4 v_Tint;
+
+void main() {
+    color = v_Tint;
+};
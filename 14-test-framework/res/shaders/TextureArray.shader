@@ -0,0 +1,35 @@
+#shader vertex
+#version 330 core
+
+// Per vertex, a unit quad centred on the origin
+layout(location = 0) in vec2 position;
+layout(location = 1) in vec2 texCoord;
+
+// Per instance, divisor 1
+layout(location = 2) in vec4 sprite; // xy = centre, z = size, w = layer
+layout(location = 3) in vec4 tint;
+
+out vec3 v_TexCoord;
+out vec4 v_Tint;
+
+uniform mat4 u_ViewProjection;
+
+void main() {
+    gl_Position = u_ViewProjection * vec4(sprite.xy + position * sprite.z, 0.0, 1.0);
+    v_TexCoord = vec3(texCoord, sprite.w);
+    v_Tint = tint;
+};
+
+#shader fragment
+#version 330 core
+
+layout(location = 0) out vec4 color;
+
+in vec3 v_TexCoord;
+in vec4 v_Tint;
+
+uniform sampler2DArray u_Textures;
+
+void main() {
+    color = texture(u_Textures, v_TexCoord) * v_Tint;
+};
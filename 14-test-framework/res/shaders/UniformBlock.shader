@@ -0,0 +1,40 @@
+#shader vertex
+#version 330 core
+
+layout(location = 0) in vec4 position;
+layout(location = 1) in vec2 texCoord;
+
+out vec2 v_TexCoord;
+
+// Written once per frame and shared by every program that declares it
+layout(std140) uniform Camera {
+    mat4 u_ViewProjection;
+};
+
+// Written once per object into the frame's ring buffer region
+layout(std140) uniform Object {
+    mat4 u_Model;
+    vec4 u_Tint;
+};
+
+void main() {
+    gl_Position = u_ViewProjection * u_Model * position;
+    v_TexCoord = texCoord;
+};
+
+#shader fragment
+#version 330 core
+
+layout(location = 0) out vec4 color;
+in vec2 v_TexCoord;
+
+layout(std140) uniform Object {
+    mat4 u_Model;
+    vec4 u_Tint;
+};
+
+uniform sampler2D u_Texture;
+
+void main() {
+    color = texture(u_Texture, v_TexCoord) * u_Tint;
+};
@@ -0,0 +1,31 @@
+#shader vertex
+#version 330 core
+
+layout(location = 0) in vec4 position;
+
+layout(std140) uniform Camera {
+    mat4 u_ViewProjection;
+};
+
+layout(std140) uniform Object {
+    mat4 u_Model;
+    vec4 u_Tint;
+};
+
+void main() {
+    gl_Position = u_ViewProjection * u_Model * position;
+};
+
+#shader fragment
+#version 330 core
+
+layout(location = 0) out vec4 color;
+
+layout(std140) uniform Object {
+    mat4 u_Model;
+    vec4 u_Tint;
+};
+
+void main() {
+    color = u_Tint;
+};
@@ -0,0 +1,321 @@
+#include "AssetPack.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+#include "BlockEncoder.h"
+#include "Mipmap.h"
+
+#include "stb_image/stb_image.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+const uint32_t Magic = 0x314B4150; // "PAK1"
+const uint32_t Version = 1;
+
+struct PackHeader {
+  uint32_t Magic;
+  uint32_t Version;
+  uint32_t EntryCount;
+  uint32_t NamesSize;
+};
+
+struct PackEntry {
+  uint64_t Offset, Size;
+  uint32_t NameOffset, NameLength;
+  uint32_t Type;
+  uint32_t Format; // CompressedImage::BlockFormat, Unknown for RGBA8
+  uint32_t Width, Height, Levels;
+  uint32_t Reserved;
+};
+static_assert(sizeof(PackHeader) == 16 && sizeof(PackEntry) == 48, "AssetPack layout changed");
+
+std::vector<std::unique_ptr<AssetPack>> s_Mounted;
+
+std::string Extension(const std::string &path) {
+  size_t dot = path.find_last_of('.');
+  if (dot == std::string::npos)
+    return "";
+  std::string extension = path.substr(dot + 1);
+  std::transform(extension.begin(), extension.end(), extension.begin(),
+                 [](unsigned char c) { return (char)std::tolower(c); });
+  return extension;
+}
+
+bool ReadFile(const std::string &path, std::vector<unsigned char> &data) {
+  std::ifstream stream(path, std::ios::binary);
+  if (!stream) {
+    std::cout << "Error: could not open " << path << std::endl;
+    return false;
+  }
+  data.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+  return true;
+}
+
+// Maps the whole file read-only; nullptr on failure
+const unsigned char *MapFile(const std::string &path, size_t &size) {
+#ifdef _WIN32
+  HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+    return nullptr;
+  LARGE_INTEGER fileSize;
+  HANDLE mapping = nullptr;
+  if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0)
+    mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  CloseHandle(file); // The mapping keeps the file open
+  if (!mapping)
+    return nullptr;
+  void *data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  CloseHandle(mapping); // And the view keeps the mapping alive
+  size = (size_t)fileSize.QuadPart;
+  return (const unsigned char *)data;
+#else
+  int file = open(path.c_str(), O_RDONLY);
+  if (file < 0)
+    return nullptr;
+  struct stat info;
+  void *data = MAP_FAILED;
+  if (fstat(file, &info) == 0 && info.st_size > 0)
+    data = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+  close(file); // The mapping keeps the file open
+  if (data == MAP_FAILED)
+    return nullptr;
+  size = (size_t)info.st_size;
+  return (const unsigned char *)data;
+#endif
+}
+
+void UnmapFile(const unsigned char *data, size_t size) {
+#ifdef _WIN32
+  (void)size;
+  UnmapViewOfFile(data);
+#else
+  munmap((void *)data, size);
+#endif
+}
+} // namespace
+
+AssetPack::AssetPack() : m_Data(nullptr), m_Size(0) {}
+
+AssetPack::~AssetPack() { Close(); }
+
+bool AssetPack::Open(const std::string &path) {
+  Close();
+  m_Data = MapFile(path, m_Size);
+  if (!m_Data) {
+    std::cout << "Error: could not map " << path << std::endl;
+    return false;
+  }
+
+  PackHeader header;
+  if (m_Size < sizeof(header)) {
+    std::cout << "Error: " << path << " is not an asset pack" << std::endl;
+    Close();
+    return false;
+  }
+  std::memcpy(&header, m_Data, sizeof(header));
+  if (header.Magic != Magic || header.Version != Version) {
+    std::cout << "Error: " << path << " is not a version " << Version << " asset pack"
+              << std::endl;
+    Close();
+    return false;
+  }
+  size_t namesOffset = sizeof(PackHeader) + (size_t)header.EntryCount * sizeof(PackEntry);
+  if (namesOffset + header.NamesSize > m_Size) {
+    std::cout << "Error: asset pack " << path << " is truncated" << std::endl;
+    Close();
+    return false;
+  }
+
+  // Only the index is read here; blobs are paged in when first touched
+  const char *names = (const char *)m_Data + namesOffset;
+  for (uint32_t i = 0; i < header.EntryCount; i++) {
+    PackEntry entry;
+    std::memcpy(&entry, m_Data + sizeof(PackHeader) + i * sizeof(PackEntry), sizeof(entry));
+    if (entry.Offset > m_Size || entry.Size > m_Size - entry.Offset ||
+        (uint64_t)entry.NameOffset + entry.NameLength > header.NamesSize) {
+      std::cout << "Error: asset pack " << path << " has a bad entry" << std::endl;
+      Close();
+      return false;
+    }
+    Asset asset;
+    asset.AssetType = (Type)entry.Type;
+    asset.Data = m_Data + entry.Offset;
+    asset.Size = (size_t)entry.Size;
+    asset.Width = (int)entry.Width;
+    asset.Height = (int)entry.Height;
+    asset.Levels = (int)entry.Levels;
+    asset.Format = (CompressedImage::BlockFormat)entry.Format;
+    m_Assets[std::string(names + entry.NameOffset, entry.NameLength)] = asset;
+  }
+  return true;
+}
+
+void AssetPack::Close() {
+  if (m_Data) {
+    UnmapFile(m_Data, m_Size);
+  }
+  m_Data = nullptr;
+  m_Size = 0;
+  m_Assets.clear();
+}
+
+const AssetPack::Asset *AssetPack::Find(const std::string &name) const {
+  auto it = m_Assets.find(name);
+  return it == m_Assets.end() ? nullptr : &it->second;
+}
+
+bool AssetPack::Mount(const std::string &path) {
+  auto pack = std::make_unique<AssetPack>();
+  if (!pack->Open(path))
+    return false;
+  std::cout << "Status: Mounted " << path << " (" << pack->GetAssetCount() << " assets)"
+            << std::endl;
+  s_Mounted.push_back(std::move(pack));
+  return true;
+}
+
+void AssetPack::UnmountAll() { s_Mounted.clear(); }
+
+const AssetPack::Asset *AssetPack::FindMounted(const std::string &name) {
+  for (auto it = s_Mounted.rbegin(); it != s_Mounted.rend(); ++it) {
+    if (const Asset *asset = (*it)->Find(name))
+      return asset;
+  }
+  return nullptr;
+}
+
+bool AssetPackWriter::AddFile(const std::string &name, const std::string &path) {
+  std::string extension = Extension(path);
+  if (extension == "shader") {
+    std::vector<unsigned char> source;
+    if (!ReadFile(path, source))
+      return false;
+    AddRaw(name, AssetPack::Type::Shader, std::move(source));
+    return true;
+  }
+  if (CompressedImage::IsCompressedFile(path)) {
+    CompressedImage image;
+    if (!image.Load(path))
+      return false;
+    AddTexture(name, image);
+    return true;
+  }
+  if (extension == "png" || extension == "jpg" || extension == "jpeg" ||
+      extension == "tga" || extension == "bmp") {
+    // Bottom row first, like Texture
+    stbi_set_flip_vertically_on_load(1);
+    int width, height, bpp;
+    unsigned char *pixels = stbi_load(path.c_str(), &width, &height, &bpp, 4);
+    if (!pixels) {
+      std::cout << "Error: failed to load " << path << ": " << stbi_failure_reason()
+                << std::endl;
+      return false;
+    }
+    AddTexture(name, width, height, pixels);
+    stbi_image_free(pixels);
+    return true;
+  }
+  std::vector<unsigned char> data;
+  if (!ReadFile(path, data))
+    return false;
+  AddRaw(name, AssetPack::Type::Raw, std::move(data));
+  return true;
+}
+
+void AssetPackWriter::AddRaw(const std::string &name, AssetPack::Type type,
+                             std::vector<unsigned char> data) {
+  m_Entries.push_back({name, type, std::move(data), 0, 0, 0,
+                       CompressedImage::BlockFormat::Unknown});
+}
+
+void AssetPackWriter::AddTexture(const std::string &name, int width, int height,
+                                 const unsigned char *pixels) {
+  if (m_Compression != CompressedImage::BlockFormat::Unknown) {
+    CompressedImage image;
+    image.Format = m_Compression;
+    image.Levels.push_back(
+        {width, height, BlockEncoder::Encode(pixels, width, height, m_Compression)});
+    for (const Mipmap::Level &level : Mipmap::BuildChain(pixels, width, height)) {
+      image.Levels.push_back({level.Width, level.Height,
+                              BlockEncoder::Encode(level.Pixels.data(), level.Width,
+                                                   level.Height, m_Compression)});
+    }
+    AddTexture(name, image);
+    return;
+  }
+  std::vector<unsigned char> data(pixels, pixels + (size_t)width * height * 4);
+  m_Entries.push_back({name, AssetPack::Type::Texture, std::move(data), width, height, 1,
+                       CompressedImage::BlockFormat::Unknown});
+}
+
+void AssetPackWriter::AddTexture(const std::string &name, const CompressedImage &image) {
+  // Levels back to back, largest first; their sizes follow from the format
+  std::vector<unsigned char> data;
+  data.reserve(image.GetSize());
+  for (const CompressedImage::Level &level : image.Levels)
+    data.insert(data.end(), level.Data.begin(), level.Data.end());
+  m_Entries.push_back({name, AssetPack::Type::Texture, std::move(data), image.GetWidth(),
+                       image.GetHeight(), (int)image.Levels.size(), image.Format});
+}
+
+bool AssetPackWriter::Save(const std::string &path) const {
+  PackHeader header = {Magic, Version, (uint32_t)m_Entries.size(), 0};
+  std::string names;
+  std::vector<PackEntry> entries(m_Entries.size());
+  for (size_t i = 0; i < m_Entries.size(); i++) {
+    entries[i] = PackEntry();
+    entries[i].NameOffset = (uint32_t)names.size();
+    entries[i].NameLength = (uint32_t)m_Entries[i].Name.size();
+    names += m_Entries[i].Name;
+  }
+  header.NamesSize = (uint32_t)names.size();
+
+  auto align = [](uint64_t offset) {
+    return (offset + AssetPack::BlobAlignment - 1) & ~(uint64_t)(AssetPack::BlobAlignment - 1);
+  };
+  uint64_t offset = align(sizeof(PackHeader) + entries.size() * sizeof(PackEntry) + names.size());
+  for (size_t i = 0; i < m_Entries.size(); i++) {
+    const auto &source = m_Entries[i];
+    entries[i].Offset = offset;
+    entries[i].Size = source.Data.size();
+    entries[i].Type = (uint32_t)source.AssetType;
+    entries[i].Format = (uint32_t)source.Format;
+    entries[i].Width = source.Width;
+    entries[i].Height = source.Height;
+    entries[i].Levels = source.Levels;
+    offset = align(offset + source.Data.size());
+  }
+
+  std::ofstream file(path, std::ios::binary);
+  if (!file) {
+    std::cout << "Error: could not write asset pack " << path << std::endl;
+    return false;
+  }
+  file.write((const char *)&header, sizeof(header));
+  file.write((const char *)entries.data(), entries.size() * sizeof(PackEntry));
+  file.write(names.data(), names.size());
+  const char padding[AssetPack::BlobAlignment] = {};
+  uint64_t written = sizeof(PackHeader) + entries.size() * sizeof(PackEntry) + names.size();
+  for (size_t i = 0; i < m_Entries.size(); i++) {
+    file.write(padding, entries[i].Offset - written);
+    file.write((const char *)m_Entries[i].Data.data(), m_Entries[i].Data.size());
+    written = entries[i].Offset + m_Entries[i].Data.size();
+  }
+  return (bool)file;
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "CompressedImage.h"
+
+// Read-only archive of shaders and textures, memory mapped so assets are
+// used in place. Textures are stored ready to upload: RGBA8 pixels bottom row
+// first, or block compressed levels largest first. That means startup does
+// no PNG decoding and no per-file opens. Built by the asset-packer tool.
+//
+// Layout, little endian:
+//   Header  "PAK1", version, entry count, name table size
+//   Entries one fixed size record per asset
+//   Names   every asset name back to back, referenced by offset and length
+//   Blobs   asset data, each starting on a BlobAlignment boundary
+class AssetPack {
+public:
+  enum class Type { Raw = 0, Shader = 1, Texture = 2 };
+
+  // An asset inside the mapping; Data stays valid while the pack is open
+  struct Asset {
+    Type AssetType = Type::Raw;
+    const unsigned char *Data = nullptr;
+    size_t Size = 0;
+    // Textures only. Format is Unknown for uncompressed RGBA8.
+    int Width = 0, Height = 0, Levels = 0;
+    CompressedImage::BlockFormat Format = CompressedImage::BlockFormat::Unknown;
+
+    inline bool IsCompressed() const {
+      return Format != CompressedImage::BlockFormat::Unknown;
+    }
+  };
+
+  static const size_t BlobAlignment = 64;
+
+  AssetPack();
+  ~AssetPack();
+  AssetPack(const AssetPack &) = delete;
+  AssetPack &operator=(const AssetPack &) = delete;
+
+  bool Open(const std::string &path);
+  void Close();
+  inline bool IsOpen() const { return m_Data != nullptr; }
+
+  // nullptr if the pack has no asset with that name
+  const Asset *Find(const std::string &name) const;
+  inline size_t GetAssetCount() const { return m_Assets.size(); }
+
+  // Mounted packs are searched by Texture and Shader before the file system,
+  // most recently mounted first. Mount before creating any GL resources;
+  // unmounting invalidates every Asset from them.
+  static bool Mount(const std::string &path);
+  static void UnmountAll();
+  static const Asset *FindMounted(const std::string &name);
+
+private:
+  const unsigned char *m_Data;
+  size_t m_Size;
+  std::unordered_map<std::string, Asset> m_Assets;
+};
+
+// Collects assets and writes them out as a pack
+class AssetPackWriter {
+public:
+  // Add PNGs and other stb_image formats as this format instead of RGBA8,
+  // with a full mip chain. Unknown keeps them uncompressed.
+  void SetCompression(CompressedImage::BlockFormat format) { m_Compression = format; }
+
+  // The type is chosen from the extension: .shader, images, .dds/.ktx2 or raw
+  bool AddFile(const std::string &name, const std::string &path);
+  void AddRaw(const std::string &name, AssetPack::Type type, std::vector<unsigned char> data);
+  void AddTexture(const std::string &name, int width, int height, const unsigned char *pixels);
+  void AddTexture(const std::string &name, const CompressedImage &image);
+
+  bool Save(const std::string &path) const;
+
+private:
+  struct Entry {
+    std::string Name;
+    AssetPack::Type AssetType;
+    std::vector<unsigned char> Data;
+    int Width, Height, Levels;
+    CompressedImage::BlockFormat Format;
+  };
+
+  CompressedImage::BlockFormat m_Compression = CompressedImage::BlockFormat::Unknown;
+  std::vector<Entry> m_Entries;
+};
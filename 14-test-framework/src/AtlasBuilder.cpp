@@ -0,0 +1,217 @@
+#include "AtlasBuilder.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include "stb_image/stb_image.h"
+
+// ImGui compiles its copy with static linkage, so we compile our own
+#define STBRP_STATIC
+#define STB_RECT_PACK_IMPLEMENTATION
+#include "imgui/imstb_rectpack.h"
+
+namespace {
+const uint32_t Magic = 0x314C5441; // "ATL1"
+
+struct Header {
+  uint32_t Magic;
+  uint32_t PageSize;
+  uint32_t PageCount;
+  uint32_t RegionCount;
+};
+
+struct RegionRecord {
+  int32_t Page, X, Y, Width, Height;
+  uint32_t NameLength; // Name bytes follow
+};
+} // namespace
+
+const AtlasData::Region *AtlasData::Find(const std::string &name) const {
+  for (const Region &region : Regions) {
+    if (region.Name == name)
+      return &region;
+  }
+  return nullptr;
+}
+
+bool AtlasData::Save(const std::string &path) const {
+  std::ofstream file(path, std::ios::binary);
+  if (!file) {
+    std::cout << "Error: could not write atlas " << path << std::endl;
+    return false;
+  }
+  Header header = {Magic, (uint32_t)PageSize, (uint32_t)Pages.size(), (uint32_t)Regions.size()};
+  file.write((const char *)&header, sizeof(header));
+  for (const Region &region : Regions) {
+    RegionRecord record = {region.Page, region.X, region.Y, region.Width, region.Height,
+                           (uint32_t)region.Name.size()};
+    file.write((const char *)&record, sizeof(record));
+    file.write(region.Name.data(), region.Name.size());
+  }
+  for (const std::vector<unsigned char> &page : Pages) {
+    file.write((const char *)page.data(), page.size());
+  }
+  return (bool)file;
+}
+
+bool AtlasData::Load(const std::string &path, int maxPageSize) {
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  uint64_t fileSize = file ? (uint64_t)file.tellg() : 0;
+  file.seekg(0);
+  Header header;
+  if (!file.read((char *)&header, sizeof(header)) || header.Magic != Magic) {
+    std::cout << "Error: " << path << " is not an atlas file" << std::endl;
+    return false;
+  }
+
+  // Every size below comes from the file, so check it against the file's
+  // length before allocating anything
+  if (header.PageSize == 0 || header.PageSize > (uint32_t)maxPageSize) {
+    std::cout << "Error: atlas " << path << " has an invalid page size " << header.PageSize
+              << std::endl;
+    return false;
+  }
+  uint64_t pageBytes = (uint64_t)header.PageSize * header.PageSize * 4;
+  if ((uint64_t)header.RegionCount * sizeof(RegionRecord) + header.PageCount * pageBytes >
+      fileSize - sizeof(header)) {
+    std::cout << "Error: atlas " << path << " is truncated" << std::endl;
+    return false;
+  }
+
+  PageSize = header.PageSize;
+  Regions.resize(header.RegionCount);
+  for (Region &region : Regions) {
+    RegionRecord record;
+    if (!file.read((char *)&record, sizeof(record))) {
+      std::cout << "Error: atlas " << path << " is truncated" << std::endl;
+      return false;
+    }
+    // Users index pages and pixels with these, so a corrupt file stops here
+    if (record.Page < 0 || (uint32_t)record.Page >= header.PageCount || record.X < 0 ||
+        record.Y < 0 || record.Width < 0 || record.Height < 0 ||
+        (int64_t)record.X + record.Width > PageSize ||
+        (int64_t)record.Y + record.Height > PageSize) {
+      std::cout << "Error: atlas " << path << " has a region outside its pages" << std::endl;
+      return false;
+    }
+    region.Page = record.Page;
+    region.X = record.X;
+    region.Y = record.Y;
+    region.Width = record.Width;
+    region.Height = record.Height;
+    if (record.NameLength > fileSize - (uint64_t)file.tellg()) {
+      std::cout << "Error: atlas " << path << " is truncated" << std::endl;
+      return false;
+    }
+    region.Name.resize(record.NameLength);
+    file.read(&region.Name[0], record.NameLength);
+  }
+  Pages.assign(header.PageCount, std::vector<unsigned char>((size_t)PageSize * PageSize * 4));
+  for (std::vector<unsigned char> &page : Pages) {
+    file.read((char *)page.data(), page.size());
+  }
+  if (!file) {
+    std::cout << "Error: atlas " << path << " is truncated" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+AtlasBuilder::AtlasBuilder(int pageSize, int padding)
+    : m_PageSize(pageSize), m_Padding(padding) {}
+
+void AtlasBuilder::Add(const std::string &name, int width, int height,
+                       const unsigned char *pixels) {
+  Image image;
+  image.Name = name;
+  image.Width = width;
+  image.Height = height;
+  image.Pixels.assign(pixels, pixels + (size_t)width * height * 4);
+  m_Images.push_back(std::move(image));
+}
+
+bool AtlasBuilder::AddFile(const std::string &path) {
+  // Bottom row first, matching Texture
+  stbi_set_flip_vertically_on_load(1);
+  int width, height, bpp;
+  unsigned char *pixels = stbi_load(path.c_str(), &width, &height, &bpp, 4);
+  if (!pixels) {
+    std::cout << "Error: failed to load " << path << ": " << stbi_failure_reason()
+              << std::endl;
+    return false;
+  }
+  Add(path, width, height, pixels);
+  stbi_image_free(pixels);
+  return true;
+}
+
+void AtlasBuilder::Blit(const Image &image, int x, int y,
+                        std::vector<unsigned char> &page) const {
+  // x, y is the padded corner; rows and columns outside the image repeat
+  // its nearest edge
+  int paddedWidth = image.Width + 2 * m_Padding;
+  for (int row = 0; row < image.Height + 2 * m_Padding; row++) {
+    int sourceRow = std::min(std::max(row - m_Padding, 0), image.Height - 1);
+    const unsigned char *source = &image.Pixels[(size_t)sourceRow * image.Width * 4];
+    unsigned char *dest = &page[((size_t)(y + row) * m_PageSize + x) * 4];
+
+    for (int column = 0; column < m_Padding; column++) {
+      std::memcpy(dest + column * 4, source, 4);
+      std::memcpy(dest + (paddedWidth - 1 - column) * 4,
+                  source + (image.Width - 1) * 4, 4);
+    }
+    std::memcpy(dest + m_Padding * 4, source, (size_t)image.Width * 4);
+  }
+}
+
+bool AtlasBuilder::Build(AtlasData &atlas) const {
+  atlas.PageSize = m_PageSize;
+  atlas.Regions.clear();
+  atlas.Pages.clear();
+
+  std::vector<stbrp_rect> pending;
+  for (int i = 0; i < (int)m_Images.size(); i++) {
+    const Image &image = m_Images[i];
+    stbrp_rect rect = {};
+    rect.id = i;
+    rect.w = image.Width + 2 * m_Padding;
+    rect.h = image.Height + 2 * m_Padding;
+    if (rect.w > m_PageSize || rect.h > m_PageSize) {
+      std::cout << "Error: " << image.Name << " does not fit in a " << m_PageSize
+                << " pixel atlas page" << std::endl;
+      return false;
+    }
+    pending.push_back(rect);
+  }
+
+  // Fill a page, then carry whatever didn't fit over to the next one
+  std::vector<stbrp_node> nodes(m_PageSize);
+  while (!pending.empty()) {
+    stbrp_context context;
+    stbrp_init_target(&context, m_PageSize, m_PageSize, nodes.data(), nodes.size());
+    stbrp_pack_rects(&context, pending.data(), pending.size());
+
+    int page = atlas.Pages.size();
+    atlas.Pages.emplace_back((size_t)m_PageSize * m_PageSize * 4, 0);
+    std::vector<stbrp_rect> remaining;
+    for (const stbrp_rect &rect : pending) {
+      if (!rect.was_packed) {
+        remaining.push_back(rect);
+        continue;
+      }
+      const Image &image = m_Images[rect.id];
+      Blit(image, rect.x, rect.y, atlas.Pages[page]);
+      atlas.Regions.push_back({image.Name, page, rect.x + m_Padding, rect.y + m_Padding,
+                               image.Width, image.Height});
+    }
+    if (remaining.size() == pending.size()) {
+      std::cout << "Error: atlas packing made no progress" << std::endl;
+      return false;
+    }
+    pending.swap(remaining);
+  }
+  return true;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+// Packed sprite sheet: one or more square RGBA8 pages plus the rectangle of
+// every sprite on them. Pixels are bottom row first like Texture. Kept free of
+// GL so the offline packer can use it; TextureAtlas uploads it.
+struct AtlasData {
+  struct Region {
+    std::string Name;
+    int Page;
+    int X, Y, Width, Height; // Pixels, origin bottom left, padding excluded
+  };
+
+  int PageSize = 0;
+  std::vector<Region> Regions;
+  std::vector<std::vector<unsigned char>> Pages; // PageSize * PageSize * 4 bytes
+
+  // nullptr if no sprite has that name
+  const Region *Find(const std::string &name) const;
+
+  // Simple binary format written by the atlas-packer tool. Load rejects pages
+  // larger than maxPageSize, which GL users should set to GL_MAX_TEXTURE_SIZE.
+  bool Save(const std::string &path) const;
+  bool Load(const std::string &path, int maxPageSize = 16384);
+};
+
+// Packs sprite images into atlas pages with stb_rect_pack (the copy ImGui
+// uses for its font atlas), opening a new page whenever one fills up.
+class AtlasBuilder {
+public:
+  // padding pixels around each sprite are filled by extruding its edges so
+  // linear filtering never picks up a neighbour
+  AtlasBuilder(int pageSize = 2048, int padding = 1);
+
+  // Copies width * height RGBA8 pixels, bottom row first
+  void Add(const std::string &name, int width, int height, const unsigned char *pixels);
+  // Loads an image file with stb_image; the file path becomes the name
+  bool AddFile(const std::string &path);
+
+  // False if a sprite is larger than a page
+  bool Build(AtlasData &atlas) const;
+
+private:
+  struct Image {
+    std::string Name;
+    int Width, Height;
+    std::vector<unsigned char> Pixels;
+  };
+
+  void Blit(const Image &image, int x, int y, std::vector<unsigned char> &page) const;
+
+  int m_PageSize, m_Padding;
+  std::vector<Image> m_Images;
+};
@@ -0,0 +1,167 @@
+#include "BatchRenderer.h"
+
+#include <algorithm>
+#include <iostream>
+
+#include "GPUProfiler.h"
+
+BatchRenderer::BatchRenderer(unsigned int maxQuads, unsigned int maxFrameQuads)
+    : m_MaxQuads(maxQuads), m_TextureSlotCount(MaxTextureSlots),
+      m_VertexPtr(nullptr), m_QuadCount(0), m_BatchQuads(0),
+      m_WarnedFrameFull(false), m_TextureSlotIndex(0) {
+  m_VAO = std::make_unique<VertexArray>();
+  m_VertexBuffer = std::make_unique<StreamingVertexBuffer>(
+      (unsigned int)sizeof(QuadVertex), maxFrameQuads * 4);
+  VertexBufferLayout layout;
+  layout.Push<float>(2); // position
+  layout.Push<float>(2); // texture coordinates
+  layout.Push<float>(4); // color
+  layout.Push<float>(1); // texture slot
+  m_VAO->AddBuffer(*m_VertexBuffer, layout);
+
+  // Every quad uses the same index pattern, so the index buffer never changes
+  std::vector<unsigned int> indices(m_MaxQuads * 6);
+  for (unsigned int i = 0, offset = 0; i < indices.size(); i += 6, offset += 4) {
+    indices[i + 0] = offset + 0;
+    indices[i + 1] = offset + 1;
+    indices[i + 2] = offset + 2;
+    indices[i + 3] = offset + 2;
+    indices[i + 4] = offset + 3;
+    indices[i + 5] = offset + 0;
+  }
+  m_IndexBuffer = std::make_unique<IndexBuffer>(indices.data(), indices.size());
+
+  // Untextured quads sample a 1x1 white texture so they can share a batch
+  // with textured ones
+  const unsigned char white[] = {255, 255, 255, 255};
+  m_WhiteTexture = std::make_unique<Texture>(1, 1, white);
+
+  int maxUnits;
+  GLCall(glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &maxUnits));
+  m_TextureSlotCount = std::min<unsigned int>(MaxTextureSlots, maxUnits);
+
+  m_Shader = std::make_unique<Shader>("res/shaders/Batch.shader");
+  m_Shader->Bind();
+  int samplers[MaxTextureSlots];
+  for (unsigned int i = 0; i < MaxTextureSlots; i++) {
+    samplers[i] = i;
+  }
+  m_Shader->SetUniform1iv("u_Textures", MaxTextureSlots, samplers);
+  m_ViewProjectionUniform = m_Shader->GetUniform<glm::mat4>("u_ViewProjection");
+}
+
+BatchRenderer::~BatchRenderer() {}
+
+void BatchRenderer::Begin(const glm::mat4 &viewProjection) {
+  m_Shader->Bind();
+  m_Shader->SetUniform(m_ViewProjectionUniform, viewProjection);
+  m_VertexBuffer->BeginFrame();
+  StartBatch();
+}
+
+void BatchRenderer::End() {
+  Flush();
+  m_VertexBuffer->EndFrame();
+}
+
+void BatchRenderer::StartBatch() {
+  // The last batch of a frame takes whatever is left rather than nothing
+  m_BatchQuads = std::min(m_MaxQuads, m_VertexBuffer->GetFreeVertices() / 4);
+  m_VertexPtr = m_BatchQuads ? (QuadVertex *)m_VertexBuffer->Map(m_BatchQuads * 4) : nullptr;
+  if (!m_VertexPtr && !m_WarnedFrameFull) {
+    std::cout << "Warning: BatchRenderer frame capacity exceeded, dropping quads" << std::endl;
+    m_WarnedFrameFull = true;
+  }
+  m_QuadCount = 0;
+  m_TextureSlots[0] = m_WhiteTexture.get();
+  m_TextureSlotIndex = 1;
+}
+
+void BatchRenderer::Flush() {
+  GPU_PROFILE_SCOPE("BatchRenderer::Flush");
+  if (!m_VertexPtr) {
+    return;
+  }
+  int baseVertex = m_VertexBuffer->Unmap(m_QuadCount * 4);
+  if (m_QuadCount == 0) {
+    return;
+  }
+
+  for (unsigned int i = 0; i < m_TextureSlotIndex; i++) {
+    m_TextureSlots[i]->Bind(i);
+  }
+  m_Renderer.Draw(*m_VAO, *m_IndexBuffer, *m_Shader, m_QuadCount * 6, baseVertex);
+
+  m_Stats.DrawCalls++;
+  m_Stats.QuadCount += m_QuadCount;
+}
+
+float BatchRenderer::GetTextureSlot(const Texture &texture) {
+  for (unsigned int i = 0; i < m_TextureSlotIndex; i++) {
+    if (m_TextureSlots[i]->GetRendererID() == texture.GetRendererID()) {
+      return (float)i;
+    }
+  }
+
+  if (m_TextureSlotIndex >= m_TextureSlotCount) {
+    Flush();
+    StartBatch();
+  }
+  m_TextureSlots[m_TextureSlotIndex] = &texture;
+  return (float)m_TextureSlotIndex++;
+}
+
+void BatchRenderer::DrawQuad(const glm::vec2 &position, const glm::vec2 &size,
+                             const glm::vec4 &color) {
+  DrawQuad(position, size, *m_WhiteTexture, color);
+}
+
+void BatchRenderer::DrawQuad(const glm::vec2 &position, const glm::vec2 &size,
+                             const Texture &texture, const glm::vec4 &tint) {
+  TextureRegion region;
+  region.Source = &texture;
+  DrawQuad(position, size, region, tint);
+}
+
+void BatchRenderer::DrawQuad(const glm::vec2 &position, const glm::vec2 &size,
+                             const TextureRegion &region, const glm::vec4 &tint) {
+  if (!m_VertexPtr) {
+    m_Stats.DroppedQuads++; // Frame full
+    return;
+  }
+  if (m_QuadCount >= m_BatchQuads) {
+    Flush();
+    StartBatch();
+    if (!m_VertexPtr) {
+      m_Stats.DroppedQuads++;
+      return;
+    }
+  }
+
+  float slot = GetTextureSlot(*region.Source);
+  if (!m_VertexPtr) {
+    m_Stats.DroppedQuads++;
+    return;
+  }
+  glm::vec2 half = size * 0.5f;
+
+  const glm::vec2 corners[] = {
+      {-half.x, -half.y}, // bottom left
+      { half.x, -half.y}, // bottom right
+      { half.x,  half.y}, // top right
+      {-half.x,  half.y}  // top left
+  };
+  const glm::vec2 texCoords[] = {region.UVMin,
+                                 {region.UVMax.x, region.UVMin.y},
+                                 region.UVMax,
+                                 {region.UVMin.x, region.UVMax.y}};
+
+  for (int i = 0; i < 4; i++) {
+    m_VertexPtr->Position = position + corners[i];
+    m_VertexPtr->TexCoord = texCoords[i];
+    m_VertexPtr->Color = tint;
+    m_VertexPtr->TexIndex = slot;
+    m_VertexPtr++;
+  }
+  m_QuadCount++;
+}
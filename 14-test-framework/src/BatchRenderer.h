@@ -0,0 +1,80 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "Renderer.h"
+#include "StreamingVertexBuffer.h"
+#include "Texture.h"
+
+// Collects textured quads into one streaming vertex buffer and draws them with
+// as few draw calls as possible. A batch is flushed when it runs out of quads or
+// texture slots, or when End() is called. Quads are written straight into the
+// mapped buffer; Begin/End are meant to be called once per frame.
+class BatchRenderer {
+public:
+  struct Stats {
+    unsigned int DrawCalls = 0;
+    unsigned int QuadCount = 0;
+    unsigned int DroppedQuads = 0; // Past the frame's vertex space
+  };
+
+  // maxQuads per draw call, maxFrameQuads over all batches of one frame
+  BatchRenderer(unsigned int maxQuads = 10000, unsigned int maxFrameQuads = 100000);
+  ~BatchRenderer();
+
+  void Begin(const glm::mat4 &viewProjection);
+  void End();
+
+  // position is the center of the quad
+  void DrawQuad(const glm::vec2 &position, const glm::vec2 &size,
+                const glm::vec4 &color);
+  void DrawQuad(const glm::vec2 &position, const glm::vec2 &size,
+                const Texture &texture,
+                const glm::vec4 &tint = glm::vec4(1.0f));
+  // Atlas sprites on the same page batch together
+  void DrawQuad(const glm::vec2 &position, const glm::vec2 &size,
+                const TextureRegion &region,
+                const glm::vec4 &tint = glm::vec4(1.0f));
+
+  inline const Stats &GetStats() const { return m_Stats; }
+  inline void ResetStats() { m_Stats = Stats(); }
+
+private:
+  struct QuadVertex {
+    glm::vec2 Position;
+    glm::vec2 TexCoord;
+    glm::vec4 Color;
+    float TexIndex;
+  };
+
+  static const unsigned int MaxTextureSlots = 16; // Must match Batch.shader
+
+  void StartBatch();
+  void Flush();
+  float GetTextureSlot(const Texture &texture);
+
+  unsigned int m_MaxQuads;
+  unsigned int m_TextureSlotCount;
+
+  std::unique_ptr<VertexArray> m_VAO;
+  std::unique_ptr<StreamingVertexBuffer> m_VertexBuffer;
+  std::unique_ptr<IndexBuffer> m_IndexBuffer;
+  std::unique_ptr<Shader> m_Shader;
+  std::unique_ptr<Texture> m_WhiteTexture;
+  Uniform<glm::mat4> m_ViewProjectionUniform;
+
+  QuadVertex *m_VertexPtr; // Into the mapped batch; nullptr once the frame is full
+  unsigned int m_QuadCount;
+  unsigned int m_BatchQuads; // Capacity of this batch, less than m_MaxQuads at the end of the frame
+  bool m_WarnedFrameFull;    // Dropped quads are counted in Stats after the first warning
+
+  std::array<const Texture *, MaxTextureSlots> m_TextureSlots;
+  unsigned int m_TextureSlotIndex;
+
+  Renderer m_Renderer;
+  Stats m_Stats;
+};
@@ -0,0 +1,367 @@
+#include "Benchmark.h"
+
+#include <GLFW/glfw3.h>
+
+#ifdef BENCHMARK_EGL
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#ifndef EGL_PLATFORM_SURFACELESS_MESA
+#define EGL_PLATFORM_SURFACELESS_MESA 0x31DD
+#endif
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+
+#include "Renderer.h"
+#include "GLDebug.h"
+#include "GPUProfiler.h"
+#include "RenderStats.h"
+
+// Offscreen context plus a framebuffer standing in for the window
+struct HeadlessContext {
+#ifdef BENCHMARK_EGL
+  EGLDisplay Display = EGL_NO_DISPLAY;
+  EGLContext Context = EGL_NO_CONTEXT;
+#endif
+  GLFWwindow *Window = nullptr;
+  unsigned int Framebuffer = 0, ColorBuffer = 0, DepthBuffer = 0;
+};
+
+#ifdef BENCHMARK_EGL
+static bool CreateEGLContext(HeadlessContext &context) {
+  // Surfaceless Mesa runs on llvmpipe with no display server or GPU
+  auto getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+  if (getPlatformDisplay) {
+    context.Display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+  }
+  if (context.Display == EGL_NO_DISPLAY) {
+    context.Display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+  }
+  if (context.Display == EGL_NO_DISPLAY || !eglInitialize(context.Display, nullptr, nullptr)) {
+    std::cout << "Warning: no EGL display available" << std::endl;
+    return false;
+  }
+
+  const EGLint configAttribs[] = {EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_NONE};
+  EGLConfig config;
+  EGLint configCount = 0;
+  if (!eglBindAPI(EGL_OPENGL_API) ||
+      !eglChooseConfig(context.Display, configAttribs, &config, 1, &configCount) ||
+      configCount == 0) {
+    std::cout << "Warning: no desktop OpenGL EGL config" << std::endl;
+    eglTerminate(context.Display);
+    return false;
+  }
+
+  const EGLint contextAttribs[] = {
+    EGL_CONTEXT_MAJOR_VERSION, 3,
+    EGL_CONTEXT_MINOR_VERSION, 3,
+    EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+#ifdef GL_ERROR_MODE_DEBUG_OUTPUT
+    EGL_CONTEXT_OPENGL_DEBUG, EGL_TRUE,
+#endif
+    EGL_NONE};
+  context.Context = eglCreateContext(context.Display, config, EGL_NO_CONTEXT, contextAttribs);
+  if (context.Context == EGL_NO_CONTEXT ||
+      !eglMakeCurrent(context.Display, EGL_NO_SURFACE, EGL_NO_SURFACE, context.Context)) {
+    std::cout << "Warning: failed to create a surfaceless EGL context" << std::endl;
+    if (context.Context != EGL_NO_CONTEXT) {
+      eglDestroyContext(context.Display, context.Context);
+      context.Context = EGL_NO_CONTEXT;
+    }
+    eglTerminate(context.Display);
+    return false;
+  }
+  std::cout << "Status: Using surfaceless EGL context" << std::endl;
+  return true;
+}
+#endif
+
+static bool CreateGLFWContext(HeadlessContext &context) {
+  if (!glfwInit()) {
+    std::cout << "Error: Failed to initialize GLFW.\n";
+    return false;
+  }
+  glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+  glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+  glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+#ifdef GL_ERROR_MODE_DEBUG_OUTPUT
+  glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GLFW_TRUE);
+#endif
+  glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+  context.Window = glfwCreateWindow(64, 64, "Learn OpenGL benchmark", NULL, NULL);
+  if (!context.Window) {
+    std::cout << "Error: Failed to create Window or OpenGL context.\n";
+    glfwTerminate();
+    return false;
+  }
+  glfwMakeContextCurrent(context.Window);
+  std::cout << "Status: Using hidden GLFW window" << std::endl;
+  return true;
+}
+
+static bool CreateHeadlessContext(HeadlessContext &context, int width, int height) {
+  bool created = false;
+#ifdef BENCHMARK_EGL
+  created = CreateEGLContext(context);
+#endif
+  if (!created && !CreateGLFWContext(context)) {
+    return false;
+  }
+
+  GLenum err = glewInit();
+#ifdef GLEW_ERROR_NO_GLX_DISPLAY
+  // GLX builds of GLEW still load the core entry points before failing here
+  if (err == GLEW_ERROR_NO_GLX_DISPLAY)
+    err = GLEW_OK;
+#endif
+  if (err != GLEW_OK) {
+    std::cout << "Error: glewInit failed: " << glewGetErrorString(err) << std::endl;
+    return false;
+  }
+  GLClearError(); // glewInit can leave GL_INVALID_ENUM behind on core profiles
+
+#ifdef GL_ERROR_MODE_DEBUG_OUTPUT
+  GLDebug::Enable();
+#endif
+
+  GLCall(glGenRenderbuffers(1, &context.ColorBuffer));
+  GLCall(glBindRenderbuffer(GL_RENDERBUFFER, context.ColorBuffer));
+  GLCall(glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height));
+  GLCall(glGenRenderbuffers(1, &context.DepthBuffer));
+  GLCall(glBindRenderbuffer(GL_RENDERBUFFER, context.DepthBuffer));
+  GLCall(glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height));
+
+  GLCall(glGenFramebuffers(1, &context.Framebuffer));
+  GLCall(glBindFramebuffer(GL_FRAMEBUFFER, context.Framebuffer));
+  GLCall(glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, context.ColorBuffer));
+  GLCall(glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, context.DepthBuffer));
+  GLenum status;
+  GLCall(status = glCheckFramebufferStatus(GL_FRAMEBUFFER));
+  if (status != GL_FRAMEBUFFER_COMPLETE) {
+    std::cout << "Error: benchmark framebuffer incomplete: 0x" << std::hex << status
+              << std::dec << std::endl;
+    return false;
+  }
+  GLState::Viewport(0, 0, width, height);
+  return true;
+}
+
+static void DestroyHeadlessContext(HeadlessContext &context) {
+  if (context.Framebuffer) {
+    GLCall(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+    GLCall(glDeleteFramebuffers(1, &context.Framebuffer));
+    GLCall(glDeleteRenderbuffers(1, &context.ColorBuffer));
+    GLCall(glDeleteRenderbuffers(1, &context.DepthBuffer));
+  }
+#ifdef BENCHMARK_EGL
+  if (context.Context != EGL_NO_CONTEXT) {
+    eglMakeCurrent(context.Display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    eglDestroyContext(context.Display, context.Context);
+    eglTerminate(context.Display);
+  }
+#endif
+  if (context.Window) {
+    glfwDestroyWindow(context.Window);
+    glfwTerminate();
+  }
+}
+
+bool Benchmark::ParseArgs(int argc, char **argv, Options &options) {
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    bool hasValue = i + 1 < argc;
+    if (arg == "--benchmark") {
+      options.Enabled = true;
+    } else if (arg == "--frames" && hasValue) {
+      options.Frames = std::atoi(argv[++i]);
+    } else if (arg == "--warmup" && hasValue) {
+      options.WarmupFrames = std::atoi(argv[++i]);
+    } else if (arg == "--size" && hasValue) {
+      if (std::sscanf(argv[++i], "%dx%d", &options.Width, &options.Height) != 2)
+        return false;
+    } else if (arg == "--test" && hasValue) {
+      options.Tests.push_back(argv[++i]);
+    } else if (arg == "--output" && hasValue) {
+      options.OutputPath = argv[++i];
+    } else {
+      std::cout << "Error: unknown argument " << arg << std::endl;
+      return false;
+    }
+  }
+  return options.Frames > 0 && options.WarmupFrames >= 0 &&
+         options.Width > 0 && options.Height > 0;
+}
+
+static std::string JsonString(const std::string &value) {
+  std::string out = "\"";
+  for (char c : value) {
+    if (c == '"' || c == '\\') {
+      out += '\\';
+      out += c;
+    } else if ((unsigned char)c < 0x20) {
+      char escaped[8];
+      std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+      out += escaped;
+    } else {
+      out += c;
+    }
+  }
+  return out + "\"";
+}
+
+// Nearest-rank percentile of sorted samples
+static double Percentile(const std::vector<double> &sorted, double percent) {
+  size_t rank = (size_t)std::ceil(percent / 100.0 * sorted.size());
+  return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+static void WriteSummary(std::ostream &out, std::vector<double> samples) {
+  std::sort(samples.begin(), samples.end());
+  double sum = 0.0;
+  for (double sample : samples)
+    sum += sample;
+  out << "{\"mean\": " << sum / samples.size()
+      << ", \"min\": " << samples.front()
+      << ", \"p50\": " << Percentile(samples, 50.0)
+      << ", \"p90\": " << Percentile(samples, 90.0)
+      << ", \"p99\": " << Percentile(samples, 99.0)
+      << ", \"max\": " << samples.back() << "}";
+}
+
+int Benchmark::Run(const test::TestMenu &menu, const Options &options, std::ostream &results) {
+  std::vector<std::string> names = options.Tests;
+  if (names.empty()) {
+    names = menu.GetTestNames();
+  }
+
+  HeadlessContext context;
+  if (!CreateHeadlessContext(context, options.Width, options.Height)) {
+    DestroyHeadlessContext(context);
+    return -1;
+  }
+
+  const char *vendor, *rendererName, *version;
+  GLCall(vendor = (const char *)glGetString(GL_VENDOR));
+  GLCall(rendererName = (const char *)glGetString(GL_RENDERER));
+  GLCall(version = (const char *)glGetString(GL_VERSION));
+
+  std::ofstream file;
+  if (!options.OutputPath.empty()) {
+    file.open(options.OutputPath);
+    if (!file) {
+      std::cout << "Error: could not open " << options.OutputPath << std::endl;
+      DestroyHeadlessContext(context);
+      return -1;
+    }
+  }
+  std::ostream &out = file.is_open() ? (std::ostream &)file : results;
+
+  out << "{\n  \"vendor\": " << JsonString(vendor ? vendor : "")
+      << ",\n  \"renderer\": " << JsonString(rendererName ? rendererName : "")
+      << ",\n  \"version\": " << JsonString(version ? version : "")
+      << ",\n  \"width\": " << options.Width << ", \"height\": " << options.Height
+      << ",\n  \"warmup\": " << options.WarmupFrames << ", \"frames\": " << options.Frames
+      << ",\n  \"tests\": [";
+
+  Renderer renderer;
+  int exitCode = 0;
+  bool first = true;
+  for (const std::string &name : names) {
+    std::unique_ptr<test::Test> test(menu.CreateTest(name));
+    if (!test) {
+      std::cout << "Error: no test named " << name << std::endl;
+      exitCode = 1;
+      continue;
+    }
+    std::cout << "Status: Benchmarking " << name << std::endl;
+
+    // Fixed 60 Hz simulation so every run computes the same frames.
+    // cpu: update + OnRender submission; frame: until glFinish returns
+    const float step = 1.0f / 60.0f;
+    std::vector<double> cpuTimes, frameTimes, gpuTimes;
+    std::vector<double> drawCalls, triangles, stateChanges, uniformUploads;
+    std::vector<double> bufferBytes, textureBytes;
+    RenderStats::EndFrame(); // Don't count the test's construction
+    for (int frame = 0; frame < options.WarmupFrames + options.Frames; frame++) {
+      GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+      renderer.Clear();
+
+      auto start = std::chrono::steady_clock::now();
+      test->OnFixedUpdate(step);
+      test->OnUpdate(step);
+      test->OnSnapshot();
+      {
+        GPU_PROFILE_SCOPE("OnRender");
+        test->OnRender();
+      }
+      auto submitted = std::chrono::steady_clock::now();
+      GLCall(glFinish());
+      auto finished = std::chrono::steady_clock::now();
+      GPUProfiler::EndFrame();
+      const RenderStats &stats = RenderStats::EndFrame();
+
+#ifdef GL_ERROR_MODE_DEBUG_OUTPUT
+      GLDebug::Flush();
+#endif
+
+      if (frame < options.WarmupFrames)
+        continue;
+      cpuTimes.push_back(std::chrono::duration<double, std::milli>(submitted - start).count());
+      frameTimes.push_back(std::chrono::duration<double, std::milli>(finished - start).count());
+      drawCalls.push_back(stats.DrawCalls);
+      triangles.push_back(stats.Triangles);
+      stateChanges.push_back(stats.StateChanges);
+      uniformUploads.push_back(stats.UniformUploads);
+      bufferBytes.push_back(stats.BufferBytes);
+      textureBytes.push_back(stats.TextureBytes);
+      // Resolved a few frames late; glFinish above means none are dropped
+      for (const GPUProfiler::Result &result : GPUProfiler::GetResults()) {
+        if (result.Depth == 0)
+          gpuTimes.push_back(result.GpuMs);
+      }
+    }
+    test.reset();
+
+    out << (first ? "\n" : ",\n") << "    {\"name\": " << JsonString(name)
+        << ",\n     \"cpu_ms\": ";
+    WriteSummary(out, cpuTimes);
+    out << ",\n     \"frame_ms\": ";
+    WriteSummary(out, frameTimes);
+    if (!gpuTimes.empty()) {
+      out << ",\n     \"gpu_ms\": ";
+      WriteSummary(out, gpuTimes);
+    }
+    out << ",\n     \"draw_calls\": ";
+    WriteSummary(out, drawCalls);
+    out << ",\n     \"triangles\": ";
+    WriteSummary(out, triangles);
+    out << ",\n     \"state_changes\": ";
+    WriteSummary(out, stateChanges);
+    out << ",\n     \"uniform_uploads\": ";
+    WriteSummary(out, uniformUploads);
+    out << ",\n     \"buffer_bytes\": ";
+    WriteSummary(out, bufferBytes);
+    out << ",\n     \"texture_bytes\": ";
+    WriteSummary(out, textureBytes);
+    out << "}";
+    first = false;
+  }
+  out << "\n  ]\n}\n";
+
+  if (file.is_open()) {
+    std::cout << "Status: Wrote benchmark results to " << options.OutputPath << std::endl;
+  }
+  GPUProfiler::Shutdown();
+  DestroyHeadlessContext(context);
+  return exitCode;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "tests/Test.h"
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Headless benchmark mode. Runs registered tests in an offscreen context
+// (EGL surfaceless when available, otherwise a hidden GLFW window) and writes
+// per-test frame time percentiles, GPU time of OnRender (where timer queries
+// are supported) and RenderStats counters as JSON:
+//
+//   a.out --benchmark [--frames N] [--warmup N] [--size WxH]
+//         [--test NAME]... [--output FILE]
+//
+// ImGui is not drawn, so only the update hooks and OnRender are timed.
+class Benchmark {
+public:
+  struct Options {
+    bool Enabled = false;
+    int Frames = 600;
+    int WarmupFrames = 60;
+    int Width = 960, Height = 540;
+    std::vector<std::string> Tests; // Empty runs every registered test
+    std::string OutputPath;         // Empty writes to stdout
+  };
+
+  // Returns false on a malformed command line
+  static bool ParseArgs(int argc, char **argv, Options &options);
+
+  // Creates and destroys its own context; returns the process exit code.
+  // Without OutputPath the JSON goes to results, main's real stdout; main
+  // points std::cout at stderr for the run so nothing else lands there.
+  static int Run(const test::TestMenu &menu, const Options &options, std::ostream &results);
+};
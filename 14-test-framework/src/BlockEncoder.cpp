@@ -0,0 +1,372 @@
+#include "BlockEncoder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+
+namespace {
+// BC7 interpolation weights for 4 bit indices, out of 64
+const int BC7Weights[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+float Clamp255(float value) { return std::min(std::max(value, 0.0f), 255.0f); }
+
+// Endpoints of the line through the block's colours that fits them best: the
+// mean plus the extent of the colours along their principal axis
+void FitLine(const unsigned char *block, int channels, float lo[4], float hi[4]) {
+  float mean[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+  for (int p = 0; p < 16; p++)
+    for (int c = 0; c < channels; c++)
+      mean[c] += block[p * 4 + c] / 16.0f;
+
+  float covariance[4][4] = {};
+  for (int p = 0; p < 16; p++) {
+    float d[4];
+    for (int c = 0; c < channels; c++)
+      d[c] = block[p * 4 + c] - mean[c];
+    for (int i = 0; i < channels; i++)
+      for (int j = 0; j < channels; j++)
+        covariance[i][j] += d[i] * d[j];
+  }
+
+  // Power iteration converges on the principal axis in a handful of steps
+  float axis[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+  for (int iteration = 0; iteration < 8; iteration++) {
+    float next[4] = {0.0f, 0.0f, 0.0f, 0.0f}, largest = 0.0f;
+    for (int i = 0; i < channels; i++) {
+      for (int j = 0; j < channels; j++)
+        next[i] += covariance[i][j] * axis[j];
+      largest = std::max(largest, std::fabs(next[i]));
+    }
+    if (largest < 1e-6f) {
+      std::memset(axis, 0, sizeof(axis)); // Every pixel is the same colour
+      break;
+    }
+    for (int i = 0; i < channels; i++)
+      axis[i] = next[i] / largest;
+  }
+  float length = 0.0f;
+  for (int c = 0; c < channels; c++)
+    length += axis[c] * axis[c];
+  length = std::sqrt(length);
+  if (length > 0.0f)
+    for (int c = 0; c < channels; c++)
+      axis[c] /= length;
+
+  float tMin = 0.0f, tMax = 0.0f;
+  for (int p = 0; p < 16; p++) {
+    float t = 0.0f;
+    for (int c = 0; c < channels; c++)
+      t += (block[p * 4 + c] - mean[c]) * axis[c];
+    tMin = std::min(tMin, t);
+    tMax = std::max(tMax, t);
+  }
+  for (int c = 0; c < channels; c++) {
+    lo[c] = Clamp255(mean[c] + tMin * axis[c]);
+    hi[c] = Clamp255(mean[c] + tMax * axis[c]);
+  }
+}
+
+// Endpoints minimising the squared error for fixed per-pixel weights, where
+// weight t means (1 - t) * lo + t * hi. False if the system is singular,
+// which happens when every pixel uses the same weight.
+bool LeastSquares(const unsigned char *block, int channels, const float weights[16],
+                  float lo[4], float hi[4]) {
+  float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+  float rhsLo[4] = {0.0f, 0.0f, 0.0f, 0.0f}, rhsHi[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+  for (int p = 0; p < 16; p++) {
+    float t = weights[p], s = 1.0f - t;
+    aa += s * s;
+    ab += s * t;
+    bb += t * t;
+    for (int c = 0; c < channels; c++) {
+      rhsLo[c] += s * block[p * 4 + c];
+      rhsHi[c] += t * block[p * 4 + c];
+    }
+  }
+  float determinant = aa * bb - ab * ab;
+  if (std::fabs(determinant) < 1e-6f)
+    return false;
+  for (int c = 0; c < channels; c++) {
+    lo[c] = Clamp255((bb * rhsLo[c] - ab * rhsHi[c]) / determinant);
+    hi[c] = Clamp255((aa * rhsHi[c] - ab * rhsLo[c]) / determinant);
+  }
+  return true;
+}
+
+int SquaredError(const unsigned char *pixel, const int *colour, int channels) {
+  int error = 0;
+  for (int c = 0; c < channels; c++) {
+    int d = pixel[c] - colour[c];
+    error += d * d;
+  }
+  return error;
+}
+
+// --- BC1 colour block, also the colour half of BC3 ---
+
+int Pack565(const float colour[3]) {
+  int r = (int)(colour[0] * 31.0f / 255.0f + 0.5f);
+  int g = (int)(colour[1] * 63.0f / 255.0f + 0.5f);
+  int b = (int)(colour[2] * 31.0f / 255.0f + 0.5f);
+  return (r << 11) | (g << 5) | b;
+}
+
+void Unpack565(int packed, int colour[3]) {
+  int r = (packed >> 11) & 31, g = (packed >> 5) & 63, b = packed & 31;
+  colour[0] = (r << 3) | (r >> 2);
+  colour[1] = (g << 2) | (g >> 4);
+  colour[2] = (b << 3) | (b >> 2);
+}
+
+// Encodes with the given endpoints and returns the squared error. Always uses
+// the four colour mode (first endpoint larger), which BC3 requires.
+int EncodeColour(const unsigned char *block, const float a[3], const float b[3],
+                 unsigned char *out, int indices[16]) {
+  int c0 = Pack565(a), c1 = Pack565(b);
+  if (c0 < c1)
+    std::swap(c0, c1);
+
+  int palette[4][3];
+  Unpack565(c0, palette[0]);
+  Unpack565(c1, palette[1]);
+  for (int c = 0; c < 3; c++) {
+    palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+    palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+  }
+  // Equal endpoints would select the three colour mode, so only index 0 is safe
+  int choices = c0 == c1 ? 1 : 4;
+
+  uint32_t bits = 0;
+  int total = 0;
+  for (int p = 0; p < 16; p++) {
+    int best = 0, bestError = SquaredError(&block[p * 4], palette[0], 3);
+    for (int i = 1; i < choices; i++) {
+      int error = SquaredError(&block[p * 4], palette[i], 3);
+      if (error < bestError) {
+        best = i;
+        bestError = error;
+      }
+    }
+    indices[p] = best;
+    bits |= (uint32_t)best << (p * 2);
+    total += bestError;
+  }
+
+  out[0] = c0 & 0xFF;
+  out[1] = c0 >> 8;
+  out[2] = c1 & 0xFF;
+  out[3] = c1 >> 8;
+  std::memcpy(&out[4], &bits, sizeof(bits));
+  return total;
+}
+
+void EncodeColourBlock(const unsigned char *block, unsigned char *out) {
+  float lo[4], hi[4];
+  FitLine(block, 3, lo, hi);
+  int indices[16];
+  int bestError = EncodeColour(block, hi, lo, out, indices);
+
+  // Weight towards the first endpoint for each BC1 index
+  const float towardsFirst[4] = {1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f};
+  for (int iteration = 0; iteration < 2 && bestError > 0; iteration++) {
+    float weights[16];
+    for (int p = 0; p < 16; p++)
+      weights[p] = towardsFirst[indices[p]];
+    if (!LeastSquares(block, 3, weights, lo, hi))
+      break;
+    unsigned char candidate[8];
+    int candidateIndices[16];
+    int error = EncodeColour(block, hi, lo, candidate, candidateIndices);
+    if (error >= bestError)
+      break;
+    bestError = error;
+    std::memcpy(out, candidate, sizeof(candidate));
+    std::memcpy(indices, candidateIndices, sizeof(candidateIndices));
+  }
+}
+
+// --- BC3 alpha block ---
+
+void EncodeAlphaBlock(const unsigned char *block, unsigned char *out) {
+  int lo = 255, hi = 0;
+  for (int p = 0; p < 16; p++) {
+    lo = std::min(lo, (int)block[p * 4 + 3]);
+    hi = std::max(hi, (int)block[p * 4 + 3]);
+  }
+  // First endpoint larger selects eight interpolated values
+  int palette[8] = {hi, lo};
+  for (int i = 2; i < 8; i++)
+    palette[i] = ((8 - i) * hi + (i - 1) * lo) / 7;
+
+  uint64_t bits = 0;
+  for (int p = 0; p < 16 && hi != lo; p++) {
+    int alpha = block[p * 4 + 3], best = 0;
+    for (int i = 1; i < 8; i++)
+      if (std::abs(palette[i] - alpha) < std::abs(palette[best] - alpha))
+        best = i;
+    bits |= (uint64_t)best << (p * 3);
+  }
+  out[0] = (unsigned char)hi;
+  out[1] = (unsigned char)lo;
+  for (int i = 0; i < 6; i++)
+    out[2 + i] = (unsigned char)(bits >> (i * 8));
+}
+
+// --- BC7 mode 6 ---
+
+struct BitWriter {
+  unsigned char *Out;
+  int Position;
+
+  void Write(uint32_t value, int bits) {
+    for (int i = 0; i < bits; i++, Position++)
+      if ((value >> i) & 1)
+        Out[Position >> 3] |= 1 << (Position & 7);
+  }
+};
+
+// Mode 6 endpoints are 7 bits per channel plus a shared low bit per endpoint
+void QuantizeBC7(const float endpoint[4], int quantized[4], int &pBit, int expanded[4]) {
+  int bestError = -1;
+  for (int p = 0; p < 2; p++) {
+    int q[4], e[4], error = 0;
+    for (int c = 0; c < 4; c++) {
+      q[c] = std::min(std::max((int)std::floor((endpoint[c] - p) / 2.0f + 0.5f), 0), 127);
+      e[c] = (q[c] << 1) | p;
+      float d = e[c] - endpoint[c];
+      error += (int)(d * d);
+    }
+    if (bestError < 0 || error < bestError) {
+      bestError = error;
+      pBit = p;
+      std::memcpy(quantized, q, sizeof(q));
+      std::memcpy(expanded, e, sizeof(e));
+    }
+  }
+}
+
+int EncodeBC7Mode6(const unsigned char *block, const float a[4], const float b[4],
+                   unsigned char *out, int indices[16]) {
+  int q[2][4], e[2][4], pBits[2];
+  QuantizeBC7(a, q[0], pBits[0], e[0]);
+  QuantizeBC7(b, q[1], pBits[1], e[1]);
+
+  int palette[16][4];
+  for (int i = 0; i < 16; i++)
+    for (int c = 0; c < 4; c++)
+      palette[i][c] = ((64 - BC7Weights[i]) * e[0][c] + BC7Weights[i] * e[1][c] + 32) >> 6;
+
+  int total = 0;
+  for (int p = 0; p < 16; p++) {
+    int best = 0, bestError = SquaredError(&block[p * 4], palette[0], 4);
+    for (int i = 1; i < 16; i++) {
+      int error = SquaredError(&block[p * 4], palette[i], 4);
+      if (error < bestError) {
+        best = i;
+        bestError = error;
+      }
+    }
+    indices[p] = best;
+    total += bestError;
+  }
+
+  // The first pixel's index is stored without its top bit, so it must be
+  // below 8. The weights are symmetric, so swapping the endpoints and
+  // mirroring the indices decodes to the same colours.
+  if (indices[0] >= 8) {
+    std::swap(q[0], q[1]);
+    std::swap(pBits[0], pBits[1]);
+    for (int p = 0; p < 16; p++)
+      indices[p] = 15 - indices[p];
+  }
+
+  std::memset(out, 0, 16);
+  BitWriter writer = {out, 0};
+  writer.Write(1 << 6, 7); // Mode 6
+  for (int c = 0; c < 4; c++) {
+    writer.Write(q[0][c], 7);
+    writer.Write(q[1][c], 7);
+  }
+  writer.Write(pBits[0], 1);
+  writer.Write(pBits[1], 1);
+  for (int p = 0; p < 16; p++)
+    writer.Write(indices[p], p == 0 ? 3 : 4);
+  return total;
+}
+} // namespace
+
+void BlockEncoder::EncodeBC1(const unsigned char *block, unsigned char *out) {
+  EncodeColourBlock(block, out);
+}
+
+void BlockEncoder::EncodeBC3(const unsigned char *block, unsigned char *out) {
+  EncodeAlphaBlock(block, out);
+  EncodeColourBlock(block, out + 8);
+}
+
+void BlockEncoder::EncodeBC7(const unsigned char *block, unsigned char *out) {
+  float lo[4], hi[4];
+  FitLine(block, 4, lo, hi);
+  int indices[16];
+  int bestError = EncodeBC7Mode6(block, lo, hi, out, indices);
+
+  for (int iteration = 0; iteration < 2 && bestError > 0; iteration++) {
+    // Indices refer to the endpoints as stored, which may have been swapped
+    float weights[16];
+    for (int p = 0; p < 16; p++)
+      weights[p] = BC7Weights[indices[p]] / 64.0f;
+    if (!LeastSquares(block, 4, weights, lo, hi))
+      break;
+    unsigned char candidate[16];
+    int candidateIndices[16];
+    int error = EncodeBC7Mode6(block, lo, hi, candidate, candidateIndices);
+    if (error >= bestError)
+      break;
+    bestError = error;
+    std::memcpy(out, candidate, sizeof(candidate));
+    std::memcpy(indices, candidateIndices, sizeof(candidateIndices));
+  }
+}
+
+std::vector<unsigned char> BlockEncoder::Encode(const unsigned char *pixels, int width,
+                                                int height,
+                                                CompressedImage::BlockFormat format) {
+  void (*encodeBlock)(const unsigned char *, unsigned char *) = nullptr;
+  switch (format) {
+  case CompressedImage::BlockFormat::BC1:
+  case CompressedImage::BlockFormat::BC1_RGB:
+    encodeBlock = EncodeBC1;
+    break;
+  case CompressedImage::BlockFormat::BC3:
+    encodeBlock = EncodeBC3;
+    break;
+  case CompressedImage::BlockFormat::BC7:
+    encodeBlock = EncodeBC7;
+    break;
+  default:
+    std::cout << "Error: no encoder for " << CompressedImage::GetFormatName(format)
+              << std::endl;
+    return {};
+  }
+
+  int blockBytes = CompressedImage::GetBlockBytes(format);
+  std::vector<unsigned char> blocks(CompressedImage::GetLevelSize(format, width, height));
+  unsigned char *out = blocks.data();
+  unsigned char block[64];
+  for (int by = 0; by < height; by += 4) {
+    for (int bx = 0; bx < width; bx += 4) {
+      for (int y = 0; y < 4; y++) {
+        int sy = std::min(by + y, height - 1);
+        for (int x = 0; x < 4; x++) {
+          int sx = std::min(bx + x, width - 1);
+          std::memcpy(&block[(y * 4 + x) * 4], &pixels[(sy * width + sx) * 4], 4);
+        }
+      }
+      encodeBlock(block, out);
+      out += blockBytes;
+    }
+  }
+  return blocks;
+}
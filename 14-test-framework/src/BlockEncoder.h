@@ -0,0 +1,25 @@
+#pragma once
+
+#include "CompressedImage.h"
+
+#include <vector>
+
+// CPU block compression for the offline bake step (see tools/TextureBaker.cpp).
+// Endpoints come from the principal axis of each block's colours, refined
+// once by least squares. That is much faster than an exhaustive search and
+// good enough for sprites. BC7 only uses mode 6, a single RGBA subset with
+// 4 bit indices, which covers most content well.
+class BlockEncoder {
+public:
+  // width * height RGBA8 pixels in, one level of blocks out, row by row in the
+  // same order as the pixels. Edge blocks repeat the last row and column.
+  // Returns nothing for formats without an encoder (ETC2).
+  static std::vector<unsigned char> Encode(const unsigned char *pixels, int width,
+                                           int height,
+                                           CompressedImage::BlockFormat format);
+
+  // One 4x4 block of RGBA8 pixels, row by row
+  static void EncodeBC1(const unsigned char *block, unsigned char *out); // 8 bytes
+  static void EncodeBC3(const unsigned char *block, unsigned char *out); // 16 bytes
+  static void EncodeBC7(const unsigned char *block, unsigned char *out); // 16 bytes
+};
@@ -0,0 +1,135 @@
+#include "CommandBuffer.h"
+
+#include "Profiler.h"
+
+namespace {
+struct BindTextureCommand {
+  const Texture *Tex;
+  unsigned int Slot;
+};
+
+struct BindGeometryCommand {
+  const VertexArray *VAO;
+  const IndexBuffer *IBO;
+};
+
+template <typename T> struct UniformCommand {
+  int Location;
+  T Value;
+};
+
+struct DrawCommand {
+  unsigned int Count;
+  int BaseVertex;
+};
+
+template <typename T> T Read(const unsigned char *&cursor) {
+  T value;
+  std::memcpy(&value, cursor, sizeof(T));
+  cursor += sizeof(T);
+  return value;
+}
+} // namespace
+
+void CommandBuffer::BindShader(Shader &shader) {
+  Shader *pointer = &shader;
+  Write(Op::BindShader, pointer);
+}
+
+void CommandBuffer::BindTexture(const Texture &texture, unsigned int slot) {
+  Write(Op::BindTexture, BindTextureCommand{&texture, slot});
+}
+
+void CommandBuffer::BindGeometry(const VertexArray &va, const IndexBuffer &ib) {
+  Write(Op::BindGeometry, BindGeometryCommand{&va, &ib});
+}
+
+void CommandBuffer::SetUniform(Uniform<int> uniform, int value) {
+  Write(Op::UniformInt, UniformCommand<int>{uniform.Location, value});
+}
+
+void CommandBuffer::SetUniform(Uniform<float> uniform, float value) {
+  Write(Op::UniformFloat, UniformCommand<float>{uniform.Location, value});
+}
+
+void CommandBuffer::SetUniform(Uniform<glm::vec4> uniform, const glm::vec4 &value) {
+  Write(Op::UniformVec4, UniformCommand<glm::vec4>{uniform.Location, value});
+}
+
+void CommandBuffer::SetUniform(Uniform<glm::mat4> uniform, const glm::mat4 &value) {
+  Write(Op::UniformMat4, UniformCommand<glm::mat4>{uniform.Location, value});
+}
+
+void CommandBuffer::Draw(unsigned int count, int baseVertex) {
+  Write(Op::Draw, DrawCommand{count, baseVertex});
+}
+
+void CommandBuffer::DrawInstanced(unsigned int instanceCount) {
+  Write(Op::DrawInstanced, instanceCount);
+}
+
+void CommandBuffer::Execute(const Renderer &renderer) const {
+  PROFILE_SCOPE("CommandBuffer::Execute");
+  Shader *shader = nullptr;
+  const VertexArray *va = nullptr;
+  const IndexBuffer *ib = nullptr;
+
+  const unsigned char *cursor = m_Data.data();
+  const unsigned char *end = cursor + m_Data.size();
+  while (cursor < end) {
+    Op op = (Op)*cursor++;
+    switch (op) {
+    case Op::BindShader:
+      shader = Read<Shader *>(cursor);
+      shader->Bind();
+      break;
+    case Op::BindTexture: {
+      auto command = Read<BindTextureCommand>(cursor);
+      command.Tex->Bind(command.Slot);
+      break;
+    }
+    case Op::BindGeometry: {
+      auto command = Read<BindGeometryCommand>(cursor);
+      va = command.VAO;
+      ib = command.IBO;
+      break;
+    }
+    case Op::UniformInt: {
+      auto command = Read<UniformCommand<int>>(cursor);
+      shader->SetUniform(Uniform<int>{command.Location}, command.Value);
+      break;
+    }
+    case Op::UniformFloat: {
+      auto command = Read<UniformCommand<float>>(cursor);
+      shader->SetUniform(Uniform<float>{command.Location}, command.Value);
+      break;
+    }
+    case Op::UniformVec4: {
+      auto command = Read<UniformCommand<glm::vec4>>(cursor);
+      shader->SetUniform(Uniform<glm::vec4>{command.Location}, command.Value);
+      break;
+    }
+    case Op::UniformMat4: {
+      auto command = Read<UniformCommand<glm::mat4>>(cursor);
+      shader->SetUniform(Uniform<glm::mat4>{command.Location}, command.Value);
+      break;
+    }
+    case Op::Draw: {
+      auto command = Read<DrawCommand>(cursor);
+      // Renderer binds the shader and geometry through GLState, so this
+      // costs nothing when they are already bound
+      renderer.Draw(*va, *ib, *shader, command.Count ? command.Count : ib->GetCount(),
+                    command.BaseVertex);
+      break;
+    }
+    case Op::DrawInstanced:
+      renderer.DrawInstanced(*va, *ib, *shader, Read<unsigned int>(cursor));
+      break;
+    }
+  }
+}
+
+void CommandBuffer::Reset() {
+  m_Data.clear();
+  m_CommandCount = 0;
+}
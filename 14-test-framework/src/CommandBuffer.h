@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "Renderer.h"
+#include "Texture.h"
+
+// A recording of bind, uniform and draw commands in plain memory. Recording
+// makes no GL calls and touches nothing shared, so worker threads can each
+// fill their own buffer in parallel (one buffer per thread). Execute replays
+// the commands on the GL thread. The objects referenced must outlive the
+// replay, and uniform handles must be resolved beforehand with
+// Shader::GetUniform on the GL thread.
+class CommandBuffer {
+public:
+  void BindShader(Shader &shader);
+  void BindTexture(const Texture &texture, unsigned int slot = 0);
+  void BindGeometry(const VertexArray &va, const IndexBuffer &ib);
+
+  // Applied to the bound shader
+  void SetUniform(Uniform<int> uniform, int value);
+  void SetUniform(Uniform<float> uniform, float value);
+  void SetUniform(Uniform<glm::vec4> uniform, const glm::vec4 &value);
+  void SetUniform(Uniform<glm::mat4> uniform, const glm::mat4 &value);
+
+  // Draw the bound geometry with the bound shader. A count of 0 draws the
+  // whole index buffer.
+  void Draw(unsigned int count = 0, int baseVertex = 0);
+  void DrawInstanced(unsigned int instanceCount);
+
+  // Issue every command in recording order. The recording is kept, so it can
+  // be replayed again until Reset.
+  void Execute(const Renderer &renderer) const;
+  // Forget the commands but keep the memory for the next recording
+  void Reset();
+
+  inline size_t GetCommandCount() const { return m_CommandCount; }
+  inline size_t GetSize() const { return m_Data.size(); }
+
+private:
+  enum class Op : uint8_t {
+    BindShader,
+    BindTexture,
+    BindGeometry,
+    UniformInt,
+    UniformFloat,
+    UniformVec4,
+    UniformMat4,
+    Draw,
+    DrawInstanced
+  };
+
+  // Commands are an Op byte followed by the payload, unaligned; replay
+  // copies each payload out with memcpy
+  template <typename T> void Write(Op op, const T &payload) {
+    size_t offset = m_Data.size();
+    m_Data.resize(offset + 1 + sizeof(T));
+    m_Data[offset] = (unsigned char)op;
+    std::memcpy(&m_Data[offset + 1], &payload, sizeof(T));
+    m_CommandCount++;
+  }
+
+  std::vector<unsigned char> m_Data;
+  size_t m_CommandCount = 0;
+};
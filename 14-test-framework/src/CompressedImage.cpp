@@ -0,0 +1,351 @@
+#include "CompressedImage.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+#include "Mipmap.h"
+
+namespace {
+// DDS layout, see "DDS File Reference" on docs.microsoft.com. Offsets are
+// from the start of the file, after the "DDS " magic.
+const uint32_t DDSMagic = 0x20534444; // "DDS "
+const size_t DDSHeaderSize = 128;     // Magic + DDS_HEADER
+const size_t DDSDX10HeaderSize = 20;
+const uint32_t DDSFlagCaps = 0x1, DDSFlagHeight = 0x2, DDSFlagWidth = 0x4,
+               DDSFlagPixelFormat = 0x1000, DDSFlagMipMapCount = 0x20000,
+               DDSFlagLinearSize = 0x80000;
+const uint32_t DDSPixelFourCC = 0x4;
+const uint32_t DDSCapsComplex = 0x8, DDSCapsTexture = 0x1000, DDSCapsMipMap = 0x400000;
+const uint32_t DDSCaps2CubeMap = 0x200, DDSCaps2Volume = 0x200000;
+const uint32_t DXGIBC1 = 71, DXGIBC1SRGB = 72, DXGIBC3 = 77, DXGIBC3SRGB = 78,
+               DXGIBC7 = 98, DXGIBC7SRGB = 99;
+const uint32_t DXGITexture2D = 3;
+
+uint32_t FourCC(const char *code) {
+  return (uint32_t)code[0] | ((uint32_t)code[1] << 8) | ((uint32_t)code[2] << 16) |
+         ((uint32_t)code[3] << 24);
+}
+
+// KTX 2.0, see the Khronos KTX File Format Specification. Only plain 2D
+// textures without supercompression are accepted.
+const unsigned char KTX2Identifier[12] = {0xAB, 'K',  'T',  'X',  ' ',  '2',
+                                          '0',  0xBB, '\r', '\n', 0x1A, '\n'};
+const size_t KTX2HeaderSize = 80;
+const size_t KTX2LevelIndexSize = 24;
+
+CompressedImage::BlockFormat FromVkFormat(uint32_t vkFormat) {
+  switch (vkFormat) {
+  case 131: // VK_FORMAT_BC1_RGB_UNORM_BLOCK
+  case 132: // VK_FORMAT_BC1_RGB_SRGB_BLOCK
+    return CompressedImage::BlockFormat::BC1_RGB;
+  case 133: // VK_FORMAT_BC1_RGBA_UNORM_BLOCK
+  case 134: // VK_FORMAT_BC1_RGBA_SRGB_BLOCK
+    return CompressedImage::BlockFormat::BC1;
+  case 137: // VK_FORMAT_BC3_UNORM_BLOCK
+  case 138: // VK_FORMAT_BC3_SRGB_BLOCK
+    return CompressedImage::BlockFormat::BC3;
+  case 145: // VK_FORMAT_BC7_UNORM_BLOCK
+  case 146: // VK_FORMAT_BC7_SRGB_BLOCK
+    return CompressedImage::BlockFormat::BC7;
+  case 147: // VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK
+  case 148: // VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK
+    return CompressedImage::BlockFormat::ETC2_RGB;
+  case 151: // VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK
+  case 152: // VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK
+    return CompressedImage::BlockFormat::ETC2_RGBA;
+  default:
+    return CompressedImage::BlockFormat::Unknown;
+  }
+}
+
+// Both containers are little endian, as is every platform this builds for
+uint32_t Read32(const std::vector<unsigned char> &file, size_t offset) {
+  uint32_t value;
+  std::memcpy(&value, &file[offset], sizeof(value));
+  return value;
+}
+
+uint64_t Read64(const std::vector<unsigned char> &file, size_t offset) {
+  uint64_t value;
+  std::memcpy(&value, &file[offset], sizeof(value));
+  return value;
+}
+
+void Write32(std::vector<unsigned char> &out, size_t offset, uint32_t value) {
+  std::memcpy(&out[offset], &value, sizeof(value));
+}
+
+std::string Extension(const std::string &path) {
+  size_t dot = path.find_last_of('.');
+  if (dot == std::string::npos)
+    return "";
+  std::string extension = path.substr(dot + 1);
+  std::transform(extension.begin(), extension.end(), extension.begin(),
+                 [](unsigned char c) { return (char)std::tolower(c); });
+  return extension;
+}
+} // namespace
+
+size_t CompressedImage::GetSize() const {
+  size_t size = 0;
+  for (const Level &level : Levels)
+    size += level.Data.size();
+  return size;
+}
+
+int CompressedImage::GetBlockBytes(BlockFormat format) {
+  switch (format) {
+  case BlockFormat::BC1:
+  case BlockFormat::BC1_RGB:
+  case BlockFormat::ETC2_RGB:
+    return 8;
+  case BlockFormat::BC3:
+  case BlockFormat::BC7:
+  case BlockFormat::ETC2_RGBA:
+    return 16;
+  default:
+    return 0;
+  }
+}
+
+size_t CompressedImage::GetLevelSize(BlockFormat format, int width, int height) {
+  size_t blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+  return blocksX * blocksY * GetBlockBytes(format);
+}
+
+const char *CompressedImage::GetFormatName(BlockFormat format) {
+  switch (format) {
+  case BlockFormat::BC1:
+    return "BC1";
+  case BlockFormat::BC1_RGB:
+    return "BC1 RGB";
+  case BlockFormat::BC3:
+    return "BC3";
+  case BlockFormat::BC7:
+    return "BC7";
+  case BlockFormat::ETC2_RGB:
+    return "ETC2 RGB";
+  case BlockFormat::ETC2_RGBA:
+    return "ETC2 RGBA";
+  default:
+    return "Unknown";
+  }
+}
+
+bool CompressedImage::IsCompressedFile(const std::string &path) {
+  std::string extension = Extension(path);
+  return extension == "dds" || extension == "ktx2";
+}
+
+bool CompressedImage::Load(const std::string &path) {
+  Format = BlockFormat::Unknown;
+  Levels.clear();
+
+  std::ifstream stream(path, std::ios::binary);
+  if (!stream) {
+    std::cout << "Error: could not open " << path << std::endl;
+    return false;
+  }
+  std::vector<unsigned char> file((std::istreambuf_iterator<char>(stream)),
+                                  std::istreambuf_iterator<char>());
+
+  bool loaded = Extension(path) == "dds" ? ParseDDS(path, file) : ParseKTX2(path, file);
+  if (!loaded) {
+    Format = BlockFormat::Unknown;
+    Levels.clear();
+  }
+  return loaded;
+}
+
+bool CompressedImage::AddLevel(const std::string &path,
+                               const std::vector<unsigned char> &file,
+                               size_t offset, int width, int height) {
+  size_t size = GetLevelSize(Format, width, height);
+  if (offset > file.size() || file.size() - offset < size) {
+    std::cout << "Error: " << path << " is truncated" << std::endl;
+    return false;
+  }
+  Level level;
+  level.Width = width;
+  level.Height = height;
+  level.Data.assign(file.begin() + offset, file.begin() + offset + size);
+  Levels.push_back(std::move(level));
+  return true;
+}
+
+bool CompressedImage::ParseDDS(const std::string &path,
+                               const std::vector<unsigned char> &file) {
+  if (file.size() < DDSHeaderSize || Read32(file, 0) != DDSMagic ||
+      Read32(file, 4) != 124) {
+    std::cout << "Error: " << path << " is not a DDS file" << std::endl;
+    return false;
+  }
+  uint32_t flags = Read32(file, 8);
+  int height = (int)Read32(file, 12);
+  int width = (int)Read32(file, 16);
+  uint32_t mipCount = Read32(file, 28);
+  uint32_t pixelFlags = Read32(file, 80);
+  uint32_t fourCC = Read32(file, 84);
+  uint32_t caps2 = Read32(file, 112);
+  size_t offset = DDSHeaderSize;
+
+  if (width <= 0 || height <= 0) {
+    std::cout << "Error: " << path << " has an invalid size" << std::endl;
+    return false;
+  }
+  if (caps2 & (DDSCaps2CubeMap | DDSCaps2Volume)) {
+    std::cout << "Error: " << path << " is a cube map or volume texture" << std::endl;
+    return false;
+  }
+  if (pixelFlags & DDSPixelFourCC) {
+    if (fourCC == FourCC("DXT1")) {
+      Format = BlockFormat::BC1;
+    } else if (fourCC == FourCC("DXT5")) {
+      Format = BlockFormat::BC3;
+    } else if (fourCC == FourCC("DX10") && file.size() >= DDSHeaderSize + DDSDX10HeaderSize) {
+      uint32_t dxgiFormat = Read32(file, offset);
+      uint32_t dimension = Read32(file, offset + 4);
+      uint32_t arraySize = Read32(file, offset + 12);
+      offset += DDSDX10HeaderSize;
+      if (dimension != DXGITexture2D || arraySize > 1) {
+        std::cout << "Error: " << path << " is not a single 2D texture" << std::endl;
+        return false;
+      }
+      if (dxgiFormat == DXGIBC1 || dxgiFormat == DXGIBC1SRGB)
+        Format = BlockFormat::BC1;
+      else if (dxgiFormat == DXGIBC3 || dxgiFormat == DXGIBC3SRGB)
+        Format = BlockFormat::BC3;
+      else if (dxgiFormat == DXGIBC7 || dxgiFormat == DXGIBC7SRGB)
+        Format = BlockFormat::BC7;
+    }
+  }
+  if (Format == BlockFormat::Unknown) {
+    std::cout << "Error: " << path << " uses an unsupported DDS pixel format" << std::endl;
+    return false;
+  }
+
+  // A corrupt count could ask for more levels than a full chain has
+  int levels = 1;
+  if ((flags & DDSFlagMipMapCount) && mipCount > 1)
+    levels = (int)std::min<uint32_t>(mipCount, Mipmap::GetLevelCount(width, height));
+  for (int i = 0; i < levels; i++) {
+    if (!AddLevel(path, file, offset, width, height))
+      return false;
+    offset += Levels.back().Data.size();
+    width = std::max(1, width / 2);
+    height = std::max(1, height / 2);
+  }
+  return true;
+}
+
+bool CompressedImage::ParseKTX2(const std::string &path,
+                                const std::vector<unsigned char> &file) {
+  if (file.size() < KTX2HeaderSize ||
+      std::memcmp(file.data(), KTX2Identifier, sizeof(KTX2Identifier)) != 0) {
+    std::cout << "Error: " << path << " is not a KTX2 file" << std::endl;
+    return false;
+  }
+  uint32_t vkFormat = Read32(file, 12);
+  int width = (int)Read32(file, 20);
+  int height = (int)Read32(file, 24);
+  uint32_t depth = Read32(file, 28);
+  uint32_t layers = Read32(file, 32);
+  uint32_t faces = Read32(file, 36);
+  uint32_t levels = std::max(Read32(file, 40), 1u); // 0 asks the loader to generate them
+  uint32_t supercompression = Read32(file, 44);
+
+  if (width <= 0 || height <= 0) {
+    std::cout << "Error: " << path << " has an invalid size" << std::endl;
+    return false;
+  }
+  if (depth > 0 || layers > 0 || faces != 1) {
+    std::cout << "Error: " << path << " is not a single 2D texture" << std::endl;
+    return false;
+  }
+  if (supercompression != 0) {
+    std::cout << "Error: " << path << " is supercompressed, which is not supported"
+              << std::endl;
+    return false;
+  }
+  Format = FromVkFormat(vkFormat);
+  if (Format == BlockFormat::Unknown) {
+    std::cout << "Error: " << path << " uses unsupported vkFormat " << vkFormat << std::endl;
+    return false;
+  }
+  levels = std::min<uint32_t>(levels, Mipmap::GetLevelCount(width, height));
+  if (file.size() < KTX2HeaderSize + levels * KTX2LevelIndexSize) {
+    std::cout << "Error: " << path << " is truncated" << std::endl;
+    return false;
+  }
+
+  // The level index lists the largest level first, wherever its data lives
+  for (uint32_t i = 0; i < levels; i++) {
+    size_t entry = KTX2HeaderSize + i * KTX2LevelIndexSize;
+    uint64_t offset = Read64(file, entry);
+    if (offset > file.size() || !AddLevel(path, file, (size_t)offset, width, height))
+      return false;
+    width = std::max(1, width / 2);
+    height = std::max(1, height / 2);
+  }
+  return true;
+}
+
+bool CompressedImage::SaveDDS(const std::string &path) const {
+  uint32_t fourCC = 0, dxgiFormat = 0;
+  switch (Format) {
+  case BlockFormat::BC1:
+  case BlockFormat::BC1_RGB:
+    fourCC = FourCC("DXT1");
+    break;
+  case BlockFormat::BC3:
+    fourCC = FourCC("DXT5");
+    break;
+  case BlockFormat::BC7:
+    fourCC = FourCC("DX10");
+    dxgiFormat = DXGIBC7;
+    break;
+  default:
+    std::cout << "Error: " << GetFormatName(Format) << " can't be stored in a DDS file"
+              << std::endl;
+    return false;
+  }
+  if (Levels.empty()) {
+    std::cout << "Error: no image to write to " << path << std::endl;
+    return false;
+  }
+
+  bool mipmapped = Levels.size() > 1;
+  std::vector<unsigned char> header(DDSHeaderSize + (dxgiFormat ? DDSDX10HeaderSize : 0), 0);
+  Write32(header, 0, DDSMagic);
+  Write32(header, 4, 124);
+  Write32(header, 8, DDSFlagCaps | DDSFlagHeight | DDSFlagWidth | DDSFlagPixelFormat |
+                         DDSFlagLinearSize | (mipmapped ? DDSFlagMipMapCount : 0));
+  Write32(header, 12, GetHeight());
+  Write32(header, 16, GetWidth());
+  Write32(header, 20, (uint32_t)Levels[0].Data.size());
+  Write32(header, 28, (uint32_t)Levels.size());
+  Write32(header, 76, 32); // DDS_PIXELFORMAT size
+  Write32(header, 80, DDSPixelFourCC);
+  Write32(header, 84, fourCC);
+  Write32(header, 108, DDSCapsTexture | (mipmapped ? DDSCapsComplex | DDSCapsMipMap : 0));
+  if (dxgiFormat) {
+    Write32(header, DDSHeaderSize, dxgiFormat);
+    Write32(header, DDSHeaderSize + 4, DXGITexture2D);
+    Write32(header, DDSHeaderSize + 12, 1); // Array size
+  }
+
+  std::ofstream file(path, std::ios::binary);
+  if (!file) {
+    std::cout << "Error: could not write " << path << std::endl;
+    return false;
+  }
+  file.write((const char *)header.data(), header.size());
+  for (const Level &level : Levels)
+    file.write((const char *)level.Data.data(), level.Data.size());
+  return (bool)file;
+}
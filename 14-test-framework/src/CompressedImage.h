@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// A block compressed image and its mip chain, read from a .dds or .ktx2
+// container. It has no GL dependency, so the texture-baker tool can use it;
+// Texture uploads it with glCompressedTexImage2D. Blocks are uploaded in file
+// order. Files are therefore expected bottom row first, like every other
+// texture here (texture-baker writes them that way). sRGB formats load as
+// their UNORM equivalent, the same way PNGs are treated.
+struct CompressedImage {
+  enum class BlockFormat {
+    Unknown,
+    BC1,      // RGB + 1 bit alpha, 8 bytes per block (DXT1)
+    BC3,      // RGBA, 16 bytes per block (DXT5)
+    BC7,      // RGBA, 16 bytes per block, higher quality than BC3
+    ETC2_RGB, // 8 bytes per block, the mobile / GL 4.3 equivalent of BC1
+    ETC2_RGBA, // 16 bytes per block
+    BC1_RGB   // BC1 without the 1 bit alpha mode, opaque (KTX2 BC1_RGB formats);
+              // last so packed asset format numbers stay the same
+  };
+
+  struct Level {
+    int Width, Height;
+    std::vector<unsigned char> Data;
+  };
+
+  BlockFormat Format = BlockFormat::Unknown;
+  std::vector<Level> Levels; // Largest first
+
+  inline int GetWidth() const { return Levels.empty() ? 0 : Levels[0].Width; }
+  inline int GetHeight() const { return Levels.empty() ? 0 : Levels[0].Height; }
+  // Compressed bytes across all levels
+  size_t GetSize() const;
+
+  // 8 or 16, 0 for Unknown. Every format here uses 4x4 blocks.
+  static int GetBlockBytes(BlockFormat format);
+  static size_t GetLevelSize(BlockFormat format, int width, int height);
+  static const char *GetFormatName(BlockFormat format);
+  // True for the extensions Load understands
+  static bool IsCompressedFile(const std::string &path);
+
+  // Picks the container from the extension
+  bool Load(const std::string &path);
+  // DDS with a DX10 header for BC7. ETC2 has no DDS encoding.
+  bool SaveDDS(const std::string &path) const;
+
+private:
+  bool ParseDDS(const std::string &path, const std::vector<unsigned char> &file);
+  bool ParseKTX2(const std::string &path, const std::vector<unsigned char> &file);
+  // Copies one level out of the file after checking it fits
+  bool AddLevel(const std::string &path, const std::vector<unsigned char> &file,
+                size_t offset, int width, int height);
+};
@@ -0,0 +1,33 @@
+#include "FrameClock.h"
+
+FrameClock::FrameClock(float fixedStep, float maxDelta)
+    : m_Started(false), m_FixedStep(fixedStep), m_MaxDelta(maxDelta),
+      m_Accumulator(0.0f) {}
+
+float FrameClock::Tick() {
+  auto now = std::chrono::steady_clock::now();
+  float delta = 0.0f;
+  if (m_Started) {
+    delta = std::chrono::duration<float>(now - m_LastTick).count();
+    if (delta > m_MaxDelta)
+      delta = m_MaxDelta;
+  }
+  m_LastTick = now;
+  m_Started = true;
+
+  m_Accumulator += delta;
+  return delta;
+}
+
+bool FrameClock::StepFixed() {
+  if (m_Accumulator < m_FixedStep)
+    return false;
+  m_Accumulator -= m_FixedStep;
+  return true;
+}
+
+void FrameClock::SetFixedStep(float fixedStep) {
+  // Keep the same fraction of a step pending so interpolation doesn't jump
+  m_Accumulator = GetAlpha() * fixedStep;
+  m_FixedStep = fixedStep;
+}
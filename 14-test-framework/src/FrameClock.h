@@ -0,0 +1,35 @@
+#pragma once
+
+#include <chrono>
+
+// Measures real frame time and accumulates it into fixed simulation steps.
+//
+//   float delta = clock.Tick();
+//   while (clock.StepFixed()) Simulate(clock.GetFixedStep());
+//   Render(clock.GetAlpha()); // blend previous and current simulation state
+class FrameClock {
+public:
+  // maxDelta caps a single frame so a stall (breakpoint, window drag) can't
+  // queue up an unbounded number of fixed steps
+  FrameClock(float fixedStep = 1.0f / 60.0f, float maxDelta = 0.25f);
+
+  // Seconds since the previous Tick (0 on the first call), clamped to maxDelta
+  float Tick();
+
+  // Consumes one fixed step from the accumulator; false when less than a step
+  // remains
+  bool StepFixed();
+
+  // Fraction of a fixed step left in the accumulator, in [0, 1)
+  inline float GetAlpha() const { return m_Accumulator / m_FixedStep; }
+  inline float GetFixedStep() const { return m_FixedStep; }
+  // Drop pending time, e.g. while simulating with variable steps instead
+  inline void ResetAccumulator() { m_Accumulator = 0.0f; }
+  void SetFixedStep(float fixedStep);
+
+private:
+  std::chrono::steady_clock::time_point m_LastTick;
+  bool m_Started;
+  float m_FixedStep, m_MaxDelta;
+  float m_Accumulator;
+};
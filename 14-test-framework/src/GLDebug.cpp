@@ -0,0 +1,121 @@
+#include "GLDebug.h"
+
+#include <atomic>
+#include <cstring>
+#include <iostream>
+
+#include "Renderer.h"
+
+namespace {
+const unsigned int Capacity = 256; // Power of two so positions wrap cleanly
+const unsigned int MaxMessageLength = 256;
+
+struct Message {
+  GLenum Source, Type, Severity;
+  GLuint ID;
+  char Text[MaxMessageLength];
+};
+
+// Bounded multi-producer ring: each slot's sequence number says whether it is
+// free for the producer at a given position or holds data for the consumer
+struct Slot {
+  std::atomic<unsigned int> Sequence;
+  Message Data;
+};
+
+Slot s_Slots[Capacity];
+std::atomic<unsigned int> s_WritePos(0);
+unsigned int s_ReadPos = 0;
+std::atomic<unsigned int> s_Dropped(0);
+
+void Push(const Message &message) {
+  unsigned int pos = s_WritePos.load(std::memory_order_relaxed);
+  Slot *slot;
+  for (;;) {
+    slot = &s_Slots[pos % Capacity];
+    unsigned int sequence = slot->Sequence.load(std::memory_order_acquire);
+    int diff = (int)(sequence - pos);
+    if (diff == 0) {
+      if (s_WritePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+        break;
+    } else if (diff < 0) {
+      s_Dropped.fetch_add(1, std::memory_order_relaxed); // Full
+      return;
+    } else {
+      pos = s_WritePos.load(std::memory_order_relaxed);
+    }
+  }
+  slot->Data = message;
+  slot->Sequence.store(pos + 1, std::memory_order_release);
+}
+
+bool Pop(Message &message) {
+  Slot &slot = s_Slots[s_ReadPos % Capacity];
+  if (slot.Sequence.load(std::memory_order_acquire) != s_ReadPos + 1)
+    return false;
+  message = slot.Data;
+  slot.Sequence.store(s_ReadPos + Capacity, std::memory_order_release);
+  s_ReadPos++;
+  return true;
+}
+
+void GLAPIENTRY DebugCallback(GLenum source, GLenum type, GLuint id,
+                              GLenum severity, GLsizei /*length*/,
+                              const GLchar *text, const void * /*userParam*/) {
+  Message message;
+  message.Source = source;
+  message.Type = type;
+  message.Severity = severity;
+  message.ID = id;
+  std::strncpy(message.Text, text, MaxMessageLength - 1);
+  message.Text[MaxMessageLength - 1] = '\0';
+  Push(message);
+}
+
+const char *SeverityName(GLenum severity) {
+  switch (severity) {
+  case GL_DEBUG_SEVERITY_HIGH:
+    return "high";
+  case GL_DEBUG_SEVERITY_MEDIUM:
+    return "medium";
+  case GL_DEBUG_SEVERITY_LOW:
+    return "low";
+  }
+  return "notification";
+}
+} // namespace
+
+bool GLDebug::Enable() {
+  if (!GLEW_VERSION_4_3 && !GLEW_KHR_debug) {
+    std::cout << "Warning: GL_KHR_debug unavailable, OpenGL errors will not be reported" << std::endl;
+    return false;
+  }
+
+  for (unsigned int i = 0; i < Capacity; i++) {
+    s_Slots[i].Sequence.store(i, std::memory_order_relaxed);
+  }
+
+  glEnable(GL_DEBUG_OUTPUT);
+  glDisable(GL_DEBUG_OUTPUT_SYNCHRONOUS); // Let the driver report whenever it likes
+  glDebugMessageCallback(DebugCallback, nullptr);
+  // Notifications are mostly buffer placement chatter
+  glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DEBUG_SEVERITY_NOTIFICATION,
+                        0, nullptr, GL_FALSE);
+  return true;
+}
+
+void GLDebug::Flush() {
+  bool error = false;
+  Message message;
+  while (Pop(message)) {
+    std::cout << "OpenGL Debug (" << SeverityName(message.Severity) << ") 0x"
+              << std::hex << message.ID << std::dec << " : " << message.Text
+              << std::endl;
+    error |= message.Type == GL_DEBUG_TYPE_ERROR;
+  }
+  ASSERT(!error);
+}
+
+unsigned int GLDebug::GetDroppedCount() {
+  return s_Dropped.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+// Error reporting through GL_KHR_debug, used when GL_ERROR_MODE is
+// DEBUG_OUTPUT. Output is asynchronous, so the driver may invoke the callback
+// from its own threads; messages are queued in a fixed-size lock-free ring and
+// printed on the main thread by Flush(). When the ring is full new messages are
+// dropped and counted rather than blocking the driver.
+class GLDebug {
+public:
+  // Requires a context created with GLFW_OPENGL_DEBUG_CONTEXT. Returns false
+  // if neither GL 4.3 nor GL_KHR_debug is available.
+  static bool Enable();
+
+  // Print queued messages. Breaks into the debugger if any was an error.
+  static void Flush();
+
+  static unsigned int GetDroppedCount();
+};
@@ -0,0 +1,243 @@
+#include "GLState.h"
+
+#include "Renderer.h"
+#include "RenderStats.h"
+
+namespace {
+// Value that never matches a real binding, so the next call is always issued
+const unsigned int Unknown = 0xFFFFFFFF;
+
+// Binding points we shadow. Anything else is passed straight through.
+const unsigned int BufferTargets[] = {GL_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER,
+                                      GL_UNIFORM_BUFFER, GL_PIXEL_UNPACK_BUFFER,
+                                      GL_DRAW_INDIRECT_BUFFER};
+const unsigned int TextureTargets[] = {GL_TEXTURE_2D, GL_TEXTURE_2D_ARRAY};
+
+const int BufferTargetCount = sizeof(BufferTargets) / sizeof(BufferTargets[0]);
+const int TextureTargetCount = sizeof(TextureTargets) / sizeof(TextureTargets[0]);
+
+struct State {
+  unsigned int Program;
+  unsigned int VertexArray;
+  unsigned int Buffers[BufferTargetCount];
+  struct {
+    unsigned int Buffer;
+    long long Offset, Size;
+  } UniformRanges[GLState::MaxUniformBufferBindings];
+  unsigned int ActiveTexture;
+  unsigned int Textures[GLState::MaxTextureUnits][TextureTargetCount];
+  unsigned int Blend; // 0, 1 or Unknown
+  unsigned int BlendSrc, BlendDst;
+  int Viewport[4];
+  bool ViewportKnown;
+};
+
+State s_State;
+GLState::Counters s_Counters;
+bool s_Initialized = false;
+
+int BufferIndex(unsigned int target) {
+  for (int i = 0; i < BufferTargetCount; i++)
+    if (BufferTargets[i] == target)
+      return i;
+  return -1;
+}
+
+int TextureIndex(unsigned int target) {
+  for (int i = 0; i < TextureTargetCount; i++)
+    if (TextureTargets[i] == target)
+      return i;
+  return -1;
+}
+
+State &Get() {
+  if (!s_Initialized) {
+    GLState::Invalidate();
+  }
+  return s_State;
+}
+
+// Returns true if the caller should issue the GL call
+bool Update(unsigned int &cached, unsigned int value) {
+  if (cached == value) {
+    s_Counters.Skipped++;
+    return false;
+  }
+  cached = value;
+  s_Counters.Issued++;
+  return true;
+}
+} // namespace
+
+void GLState::UseProgram(unsigned int program) {
+  if (Update(Get().Program, program)) {
+    RenderStats::Get().ProgramBinds++;
+    GLCall(glUseProgram(program));
+  }
+}
+
+void GLState::BindVertexArray(unsigned int vao) {
+  State &state = Get();
+  if (Update(state.VertexArray, vao)) {
+    RenderStats::Get().VertexArrayBinds++;
+    GLCall(glBindVertexArray(vao));
+    // The element array binding is part of the VAO, so it changes with it
+    state.Buffers[BufferIndex(GL_ELEMENT_ARRAY_BUFFER)] = Unknown;
+  }
+}
+
+void GLState::BindBuffer(unsigned int target, unsigned int buffer) {
+  int index = BufferIndex(target);
+  if (index < 0) {
+    s_Counters.Issued++;
+    RenderStats::Get().BufferBinds++;
+    GLCall(glBindBuffer(target, buffer));
+    return;
+  }
+  if (Update(Get().Buffers[index], buffer)) {
+    RenderStats::Get().BufferBinds++;
+    GLCall(glBindBuffer(target, buffer));
+  }
+}
+
+void GLState::BindUniformBufferRange(unsigned int index, unsigned int buffer,
+                                     long long offset, long long size) {
+  State &state = Get();
+  if (index < MaxUniformBufferBindings) {
+    auto &range = state.UniformRanges[index];
+    if (range.Buffer == buffer && range.Offset == offset && range.Size == size) {
+      s_Counters.Skipped++;
+      return;
+    }
+    range.Buffer = buffer;
+    range.Offset = offset;
+    range.Size = size;
+  }
+  s_Counters.Issued++;
+  RenderStats::Get().BufferBinds++;
+  GLCall(glBindBufferRange(GL_UNIFORM_BUFFER, index, buffer, offset, size));
+  state.Buffers[BufferIndex(GL_UNIFORM_BUFFER)] = buffer;
+}
+
+void GLState::BindTexture(unsigned int unit, unsigned int target, unsigned int texture) {
+  State &state = Get();
+  int index = TextureIndex(target);
+  if (index < 0 || unit >= MaxTextureUnits) {
+    s_Counters.Issued += 2;
+    RenderStats::Get().TextureBinds++;
+    state.ActiveTexture = unit;
+    GLCall(glActiveTexture(GL_TEXTURE0 + unit));
+    GLCall(glBindTexture(target, texture));
+    return;
+  }
+  if (state.Textures[unit][index] == texture) {
+    s_Counters.Skipped++;
+    // Callers that bind to edit (glTexParameter, glTexSubImage) act on the
+    // active unit, so it still has to be this one
+    if (state.ActiveTexture != unit) {
+      state.ActiveTexture = unit;
+      s_Counters.Issued++;
+      GLCall(glActiveTexture(GL_TEXTURE0 + unit));
+    }
+    return;
+  }
+  if (Update(state.ActiveTexture, unit)) {
+    GLCall(glActiveTexture(GL_TEXTURE0 + unit));
+  }
+  state.Textures[unit][index] = texture;
+  s_Counters.Issued++;
+  RenderStats::Get().TextureBinds++;
+  GLCall(glBindTexture(target, texture));
+}
+
+void GLState::SetBlend(bool enabled) {
+  if (Update(Get().Blend, enabled ? 1 : 0)) {
+    if (enabled) {
+      GLCall(glEnable(GL_BLEND));
+    } else {
+      GLCall(glDisable(GL_BLEND));
+    }
+  }
+}
+
+void GLState::BlendFunc(unsigned int src, unsigned int dst) {
+  State &state = Get();
+  if (state.BlendSrc == src && state.BlendDst == dst) {
+    s_Counters.Skipped++;
+    return;
+  }
+  state.BlendSrc = src;
+  state.BlendDst = dst;
+  s_Counters.Issued++;
+  GLCall(glBlendFunc(src, dst));
+}
+
+void GLState::Viewport(int x, int y, int width, int height) {
+  State &state = Get();
+  if (state.ViewportKnown && state.Viewport[0] == x && state.Viewport[1] == y &&
+      state.Viewport[2] == width && state.Viewport[3] == height) {
+    s_Counters.Skipped++;
+    return;
+  }
+  state.Viewport[0] = x;
+  state.Viewport[1] = y;
+  state.Viewport[2] = width;
+  state.Viewport[3] = height;
+  state.ViewportKnown = true;
+  s_Counters.Issued++;
+  GLCall(glViewport(x, y, width, height));
+}
+
+void GLState::OnDeleteProgram(unsigned int program) {
+  State &state = Get();
+  if (state.Program == program)
+    state.Program = Unknown;
+}
+
+void GLState::OnDeleteVertexArray(unsigned int vao) {
+  State &state = Get();
+  if (state.VertexArray == vao) {
+    state.VertexArray = 0;
+    state.Buffers[BufferIndex(GL_ELEMENT_ARRAY_BUFFER)] = Unknown;
+  }
+}
+
+void GLState::OnDeleteBuffer(unsigned int buffer) {
+  State &state = Get();
+  for (unsigned int &bound : state.Buffers)
+    if (bound == buffer)
+      bound = 0;
+  for (auto &range : state.UniformRanges)
+    if (range.Buffer == buffer)
+      range.Buffer = Unknown;
+}
+
+void GLState::OnDeleteTexture(unsigned int texture) {
+  State &state = Get();
+  for (auto &unit : state.Textures)
+    for (unsigned int &bound : unit)
+      if (bound == texture)
+        bound = 0;
+}
+
+void GLState::Invalidate() {
+  s_State.Program = Unknown;
+  s_State.VertexArray = Unknown;
+  for (unsigned int &bound : s_State.Buffers)
+    bound = Unknown;
+  for (auto &range : s_State.UniformRanges)
+    range.Buffer = Unknown;
+  s_State.ActiveTexture = Unknown;
+  for (auto &unit : s_State.Textures)
+    for (unsigned int &bound : unit)
+      bound = Unknown;
+  s_State.Blend = Unknown;
+  s_State.BlendSrc = Unknown;
+  s_State.BlendDst = Unknown;
+  s_State.ViewportKnown = false;
+  s_Initialized = true;
+}
+
+const GLState::Counters &GLState::GetCounters() { return s_Counters; }
+
+void GLState::ResetCounters() { s_Counters = Counters(); }
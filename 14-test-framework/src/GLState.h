@@ -0,0 +1,43 @@
+#pragma once
+
+// Process-wide shadow copy of the GL bindings the wrapper classes change most
+// often. Everything that binds a program, VAO, buffer or texture, or touches
+// blending or the viewport, goes through here so calls that would not change
+// anything are never sent to the driver.
+class GLState {
+public:
+  struct Counters {
+    unsigned int Issued = 0;  // Calls forwarded to GL
+    unsigned int Skipped = 0; // Calls dropped because the state already matched
+  };
+
+  static const unsigned int MaxTextureUnits = 32;
+  static const unsigned int MaxUniformBufferBindings = 16;
+
+  static void UseProgram(unsigned int program);
+  static void BindVertexArray(unsigned int vao);
+  static void BindBuffer(unsigned int target, unsigned int buffer);
+  // Indexed GL_UNIFORM_BUFFER binding; also sets the generic binding like GL does
+  static void BindUniformBufferRange(unsigned int index, unsigned int buffer,
+                                     long long offset, long long size);
+  // Leaves unit active even when the binding is cached, so edits that follow
+  // (glTexParameter, glTexSubImage) reach this texture
+  static void BindTexture(unsigned int unit, unsigned int target, unsigned int texture);
+  static void SetBlend(bool enabled);
+  static void BlendFunc(unsigned int src, unsigned int dst);
+  static void Viewport(int x, int y, int width, int height);
+
+  // GL unbinds deleted objects itself; mirror that so a recycled name is not
+  // mistaken for one that is still bound
+  static void OnDeleteProgram(unsigned int program);
+  static void OnDeleteVertexArray(unsigned int vao);
+  static void OnDeleteBuffer(unsigned int buffer);
+  static void OnDeleteTexture(unsigned int texture);
+
+  // Forget everything. Call after code that changes GL state without going
+  // through this class, e.g. the ImGui backend
+  static void Invalidate();
+
+  static const Counters &GetCounters();
+  static void ResetCounters();
+};
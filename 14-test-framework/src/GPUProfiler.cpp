@@ -0,0 +1,149 @@
+#include "GPUProfiler.h"
+
+#include "Renderer.h"
+
+#include "imgui/imgui.h"
+
+unsigned int GPUProfiler::s_Queries[FrameLatency][2 * MaxScopes];
+std::vector<GPUProfiler::Scope> GPUProfiler::s_Scopes[FrameLatency];
+uint32_t GPUProfiler::s_LastQuery[FrameLatency];
+std::vector<GPUProfiler::Result> GPUProfiler::s_Results;
+bool GPUProfiler::s_Initialized = false;
+int GPUProfiler::s_Slot = 0;
+uint32_t GPUProfiler::s_Depth = 0;
+unsigned int GPUProfiler::s_Dropped = 0;
+
+bool GPUProfiler::IsSupported() {
+  return GLEW_VERSION_3_3 || GLEW_ARB_timer_query;
+}
+
+uint32_t GPUProfiler::BeginScope(const char *name) {
+  if (!s_Initialized) {
+    if (!IsSupported())
+      return InvalidScope;
+    for (int slot = 0; slot < FrameLatency; slot++) {
+      GLCall(glGenQueries(2 * MaxScopes, s_Queries[slot]));
+      s_Scopes[slot].reserve(MaxScopes);
+    }
+    s_Initialized = true;
+  }
+
+  std::vector<Scope> &scopes = s_Scopes[s_Slot];
+  if (scopes.size() >= MaxScopes) {
+    s_Dropped++;
+    return InvalidScope;
+  }
+  uint32_t scope = scopes.size();
+  scopes.push_back({name, s_Depth++, Profiler::Now(), 0});
+  GLCall(glQueryCounter(s_Queries[s_Slot][2 * scope], GL_TIMESTAMP));
+  s_LastQuery[s_Slot] = 2 * scope;
+  return scope;
+}
+
+void GPUProfiler::EndScope(uint32_t scope) {
+  if (scope == InvalidScope)
+    return;
+  GLCall(glQueryCounter(s_Queries[s_Slot][2 * scope + 1], GL_TIMESTAMP));
+  s_LastQuery[s_Slot] = 2 * scope + 1;
+  Scope &recorded = s_Scopes[s_Slot][scope];
+  recorded.CpuEnd = Profiler::Now();
+  s_Depth = recorded.Depth;
+}
+
+void GPUProfiler::EndFrame() {
+  if (!s_Initialized)
+    return;
+  s_Slot = (s_Slot + 1) % FrameLatency;
+  // The slot we are about to reuse was recorded FrameLatency - 1 frames ago
+  Resolve(s_Slot);
+  s_Scopes[s_Slot].clear();
+  s_Depth = 0;
+}
+
+void GPUProfiler::Resolve(int slot) {
+  std::vector<Scope> &scopes = s_Scopes[slot];
+  if (scopes.empty())
+    return;
+
+  // Queries complete in order, so the one issued last tells us about all of
+  // them. Never wait: drop the frame if the GPU is further behind than that.
+  int available = 0;
+  GLCall(glGetQueryObjectiv(s_Queries[slot][s_LastQuery[slot]],
+                            GL_QUERY_RESULT_AVAILABLE, &available));
+  if (!available) {
+    s_Dropped += scopes.size();
+    return;
+  }
+
+  s_Results.clear();
+  for (uint32_t i = 0; i < scopes.size(); i++) {
+    GLuint64 begin, end;
+    GLCall(glGetQueryObjectui64v(s_Queries[slot][2 * i], GL_QUERY_RESULT, &begin));
+    GLCall(glGetQueryObjectui64v(s_Queries[slot][2 * i + 1], GL_QUERY_RESULT, &end));
+    float gpuMs = (end - begin) / 1e6f;
+    float cpuMs = (scopes[i].CpuEnd - scopes[i].CpuStart) / 1e6f;
+
+    Result *result = nullptr;
+    for (Result &existing : s_Results) {
+      if (existing.Name == scopes[i].Name && existing.Depth == scopes[i].Depth) {
+        result = &existing;
+        break;
+      }
+    }
+    if (result) {
+      result->Count++;
+      result->CpuMs += cpuMs;
+      result->GpuMs += gpuMs;
+    } else {
+      s_Results.push_back({scopes[i].Name, scopes[i].Depth, 1, cpuMs, gpuMs});
+    }
+  }
+}
+
+const std::vector<GPUProfiler::Result> &GPUProfiler::GetResults() {
+  return s_Results;
+}
+
+void GPUProfiler::Shutdown() {
+  if (!s_Initialized)
+    return;
+  for (int slot = 0; slot < FrameLatency; slot++) {
+    GLCall(glDeleteQueries(2 * MaxScopes, s_Queries[slot]));
+    s_Scopes[slot].clear();
+  }
+  s_Results.clear();
+  s_Initialized = false;
+}
+
+void GPUProfiler::OnImGuiRender() {
+  if (!IsSupported()) {
+    ImGui::Text("GPU timer queries not supported");
+    return;
+  }
+
+  ImGui::Columns(3, "GPU passes");
+  ImGui::Text("Pass");
+  ImGui::NextColumn();
+  ImGui::Text("CPU ms");
+  ImGui::NextColumn();
+  ImGui::Text("GPU ms");
+  ImGui::NextColumn();
+  ImGui::Separator();
+  for (const Result &result : s_Results) {
+    ImGui::Indent(1.0f + result.Depth * 12.0f);
+    if (result.Count > 1)
+      ImGui::Text("%s (x%u)", result.Name, result.Count);
+    else
+      ImGui::Text("%s", result.Name);
+    ImGui::Unindent(1.0f + result.Depth * 12.0f);
+    ImGui::NextColumn();
+    ImGui::Text("%.3f", result.CpuMs);
+    ImGui::NextColumn();
+    ImGui::Text("%.3f", result.GpuMs);
+    ImGui::NextColumn();
+  }
+  ImGui::Columns(1);
+  if (s_Dropped) {
+    ImGui::Text("%u scopes dropped", s_Dropped);
+  }
+}
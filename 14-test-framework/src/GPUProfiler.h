@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Profiler.h"
+
+// GPU timing for render passes. GPU_PROFILE_SCOPE brackets the GL commands
+// issued in its scope with GL_TIMESTAMP queries (which, unlike
+// GL_TIME_ELAPSED, may nest) and opens a CPU PROFILE_SCOPE of the same name.
+// Queries come from a ring of FrameLatency frames and are read back when
+// their slot comes round again, so reading never stalls the pipeline.
+// GL thread only.
+#ifdef PROFILER_ENABLED
+#define GPU_PROFILE_SCOPE(name) PROFILE_SCOPE(name); \
+  GPUProfileScope PROFILE_CONCAT(gpuProfileScope, __LINE__)(name)
+#else
+#define GPU_PROFILE_SCOPE(name)
+#endif
+
+class GPUProfiler {
+public:
+  // Scopes with the same name and depth in one frame are summed
+  struct Result {
+    const char *Name;
+    uint32_t Depth;
+    uint32_t Count;
+    float CpuMs, GpuMs;
+  };
+
+  static bool IsSupported();
+
+  // Call once per frame after the frame's last GPU scope
+  static void EndFrame();
+  // Delete the queries while the context is still current
+  static void Shutdown();
+
+  // Most recent frame whose queries have resolved
+  static const std::vector<Result> &GetResults();
+  // CPU vs GPU time per pass
+  static void OnImGuiRender();
+
+  // Used by GPUProfileScope; BeginScope returns InvalidScope when the frame's
+  // queries are used up or timer queries are unsupported
+  static const uint32_t InvalidScope = 0xFFFFFFFF;
+  static uint32_t BeginScope(const char *name);
+  static void EndScope(uint32_t scope);
+
+private:
+  static const int FrameLatency = 4;
+  static const uint32_t MaxScopes = 256; // Per frame
+
+  struct Scope {
+    const char *Name;
+    uint32_t Depth;
+    int64_t CpuStart, CpuEnd;
+  };
+
+  static void Resolve(int slot);
+
+  // Scope i of a slot uses queries 2i (begin) and 2i + 1 (end)
+  static unsigned int s_Queries[FrameLatency][2 * MaxScopes];
+  static std::vector<Scope> s_Scopes[FrameLatency];
+  // Query issued last in each slot. With nesting this is an outer scope's
+  // end, not the end of the scope pushed last.
+  static uint32_t s_LastQuery[FrameLatency];
+  static std::vector<Result> s_Results;
+  static bool s_Initialized;
+  static int s_Slot;
+  static uint32_t s_Depth;
+  static unsigned int s_Dropped; // Over MaxScopes, or not ready in time
+};
+
+class GPUProfileScope {
+public:
+  GPUProfileScope(const char *name) : m_Scope(GPUProfiler::BeginScope(name)) {}
+  ~GPUProfileScope() { GPUProfiler::EndScope(m_Scope); }
+
+private:
+  uint32_t m_Scope;
+};
@@ -0,0 +1,154 @@
+#include "GeometryArena.h"
+
+#include <algorithm>
+
+#include "Profiler.h"
+#include "Renderer.h"
+
+GeometryArena::GeometryArena(const VertexBufferLayout &vertexLayout,
+                             unsigned int vertexCapacity, unsigned int indexCapacity)
+    : m_Layout(vertexLayout), m_VertexRanges(vertexCapacity),
+      m_IndexRanges(indexCapacity) {
+  m_VertexBuffer = std::make_unique<VertexBuffer>(vertexCapacity * m_Layout.GetStride());
+  m_IndexBuffer = std::make_unique<IndexBuffer>(indexCapacity);
+  m_VAO = std::make_unique<VertexArray>();
+  m_VAO->AddBuffer(*m_VertexBuffer, m_Layout);
+}
+
+GeometryArena::~GeometryArena() {}
+
+unsigned int GeometryArena::Add(const void *vertices, unsigned int vertexCount,
+                                const unsigned int *indices, unsigned int indexCount) {
+  ASSERT(vertexCount > 0 && indexCount > 0);
+  unsigned int baseVertex = m_VertexRanges.Allocate(vertexCount);
+  unsigned int firstIndex = m_IndexRanges.Allocate(indexCount);
+  if (baseVertex == RangeAllocator::Invalid || firstIndex == RangeAllocator::Invalid) {
+    if (baseVertex != RangeAllocator::Invalid)
+      m_VertexRanges.Free(baseVertex, vertexCount);
+    if (firstIndex != RangeAllocator::Invalid)
+      m_IndexRanges.Free(firstIndex, indexCount);
+
+    // Packing alone is enough when the free space just isn't contiguous
+    unsigned int vertexCapacity = m_VertexRanges.GetCapacity();
+    unsigned int indexCapacity = m_IndexRanges.GetCapacity();
+    if (m_VertexRanges.GetFree() < vertexCount)
+      vertexCapacity = std::max(vertexCapacity * 2, vertexCapacity - m_VertexRanges.GetFree() + vertexCount);
+    if (m_IndexRanges.GetFree() < indexCount)
+      indexCapacity = std::max(indexCapacity * 2, indexCapacity - m_IndexRanges.GetFree() + indexCount);
+    Repack(vertexCapacity, indexCapacity);
+
+    baseVertex = m_VertexRanges.Allocate(vertexCount);
+    firstIndex = m_IndexRanges.Allocate(indexCount);
+  }
+
+  unsigned int stride = m_Layout.GetStride();
+  m_VertexBuffer->SetData(vertices, vertexCount * stride, baseVertex * stride);
+  m_IndexBuffer->SetData(indices, indexCount, firstIndex);
+  m_IndexBuffer->SetCount(m_IndexRanges.GetEnd());
+
+  Mesh mesh = {firstIndex, indexCount, (int)baseVertex, vertexCount};
+  if (m_FreeIDs.empty()) {
+    m_Meshes.push_back(mesh);
+    return m_Meshes.size() - 1;
+  }
+  unsigned int id = m_FreeIDs.back();
+  m_FreeIDs.pop_back();
+  m_Meshes[id] = mesh;
+  return id;
+}
+
+void GeometryArena::Remove(unsigned int id) {
+  Mesh &mesh = m_Meshes[id];
+  ASSERT(mesh.IndexCount > 0);
+  m_VertexRanges.Free(mesh.BaseVertex, mesh.VertexCount);
+  m_IndexRanges.Free(mesh.FirstIndex, mesh.IndexCount);
+  m_IndexBuffer->SetCount(m_IndexRanges.GetEnd());
+  mesh = Mesh();
+  m_FreeIDs.push_back(id);
+}
+
+void GeometryArena::Defragment() {
+  Repack(m_VertexRanges.GetCapacity(), m_IndexRanges.GetCapacity());
+}
+
+float GeometryArena::GetFragmentation() const {
+  auto fragmentation = [](const RangeAllocator &ranges) {
+    unsigned int free = ranges.GetFree();
+    return free ? 1.0f - (float)ranges.GetLargestFree() / free : 0.0f;
+  };
+  return std::max(fragmentation(m_VertexRanges), fragmentation(m_IndexRanges));
+}
+
+void GeometryArena::Repack(unsigned int vertexCapacity, unsigned int indexCapacity) {
+  PROFILE_SCOPE("GeometryArena::Repack");
+  unsigned int stride = m_Layout.GetStride();
+  auto vertexBuffer = std::make_unique<VertexBuffer>(vertexCapacity * stride);
+  auto indexBuffer = std::make_unique<IndexBuffer>(indexCapacity);
+
+  std::vector<Mesh *> live;
+  for (Mesh &mesh : m_Meshes)
+    if (mesh.IndexCount > 0)
+      live.push_back(&mesh);
+
+  // Copies on the GPU, neighbouring ranges that stay neighbours in one call.
+  // The copy targets are not part of any VAO, so the element array binding
+  // of whichever VAO is bound is left alone.
+  auto copyRanges = [](unsigned int from, unsigned int to,
+                       const std::vector<std::pair<unsigned int, unsigned int>> &moves,
+                       unsigned int unit) {
+    GLState::BindBuffer(GL_COPY_READ_BUFFER, from);
+    GLState::BindBuffer(GL_COPY_WRITE_BUFFER, to);
+    unsigned int runSource = 0, runTarget = 0, runSize = 0;
+    auto flush = [&]() {
+      if (runSize) {
+        GLCall(glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, runSource * unit,
+                                   runTarget * unit, runSize * unit));
+      }
+    };
+    for (const auto &move : moves) {
+      unsigned int source = move.first, size = move.second;
+      if (runSize && runSource + runSize == source) {
+        runSize += size;
+        continue;
+      }
+      flush();
+      runTarget += runSize;
+      runSource = source;
+      runSize = size;
+    }
+    flush();
+  };
+
+  std::vector<std::pair<unsigned int, unsigned int>> moves;
+  std::sort(live.begin(), live.end(),
+            [](const Mesh *a, const Mesh *b) { return a->BaseVertex < b->BaseVertex; });
+  unsigned int usedVertices = 0;
+  for (Mesh *mesh : live) {
+    moves.push_back({(unsigned int)mesh->BaseVertex, mesh->VertexCount});
+    mesh->BaseVertex = usedVertices;
+    usedVertices += mesh->VertexCount;
+  }
+  copyRanges(m_VertexBuffer->GetRendererID(), vertexBuffer->GetRendererID(), moves, stride);
+
+  moves.clear();
+  std::sort(live.begin(), live.end(),
+            [](const Mesh *a, const Mesh *b) { return a->FirstIndex < b->FirstIndex; });
+  unsigned int usedIndices = 0;
+  for (Mesh *mesh : live) {
+    moves.push_back({mesh->FirstIndex, mesh->IndexCount});
+    mesh->FirstIndex = usedIndices;
+    usedIndices += mesh->IndexCount;
+  }
+  copyRanges(m_IndexBuffer->GetRendererID(), indexBuffer->GetRendererID(), moves,
+             sizeof(unsigned int));
+
+  m_VertexRanges.Reset(vertexCapacity, usedVertices);
+  m_IndexRanges.Reset(indexCapacity, usedIndices);
+
+  // Attribute pointers name the old vertex buffer, so the VAO goes too
+  m_VertexBuffer = std::move(vertexBuffer);
+  m_IndexBuffer = std::move(indexBuffer);
+  m_IndexBuffer->SetCount(usedIndices);
+  m_VAO = std::make_unique<VertexArray>();
+  m_VAO->AddBuffer(*m_VertexBuffer, m_Layout);
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "IndexBuffer.h"
+#include "RangeAllocator.h"
+#include "VertexArray.h"
+#include "VertexBuffer.h"
+#include "VertexBufferLayout.h"
+
+// Vertex and index storage shared by many meshes. Each mesh is a range of one
+// large vertex buffer and one large index buffer, so all of them draw from the
+// same VAO with Renderer::Draw(..., count, baseVertex, firstIndex) or a single
+// Renderer::MultiDrawIndirect, instead of a buffer pair and VAO bind per mesh.
+//
+// Ranges come from a best-fit free list per buffer. Removing meshes leaves
+// holes; Defragment packs the live ranges to the front again. When no hole is
+// large enough, Add packs first and grows the buffers only if that is not
+// enough. Both replace the buffers and the VAO, so fetch them with
+// GetVertexArray/GetIndexBuffer when drawing rather than keeping references.
+// The index buffer's count runs to the end of the last live mesh, so a whole
+// buffer draw covers every mesh, plus the stale contents of any holes until
+// the next Defragment.
+class GeometryArena {
+public:
+  struct Mesh {
+    unsigned int FirstIndex, IndexCount;
+    int BaseVertex;
+    unsigned int VertexCount;
+  };
+
+  // vertexLayout describes one vertex of every mesh
+  GeometryArena(const VertexBufferLayout &vertexLayout, unsigned int vertexCapacity,
+                unsigned int indexCapacity);
+  ~GeometryArena();
+
+  // Copy a mesh in; indices count from its first vertex. The returned ID stays
+  // valid until Remove, Defragment and growth included.
+  unsigned int Add(const void *vertices, unsigned int vertexCount,
+                   const unsigned int *indices, unsigned int indexCount);
+  void Remove(unsigned int id);
+
+  // Move every mesh to the front of fresh buffers so free space is one range
+  void Defragment();
+
+  inline const Mesh &GetMesh(unsigned int id) const { return m_Meshes[id]; }
+  inline const VertexArray &GetVertexArray() const { return *m_VAO; }
+  inline const IndexBuffer &GetIndexBuffer() const { return *m_IndexBuffer; }
+
+  inline unsigned int GetMeshCount() const { return m_Meshes.size() - m_FreeIDs.size(); }
+  inline const RangeAllocator &GetVertexRanges() const { return m_VertexRanges; }
+  inline const RangeAllocator &GetIndexRanges() const { return m_IndexRanges; }
+  // Share of free space outside the largest hole, the worse of the vertex and
+  // index buffers; 0 when both are contiguous
+  float GetFragmentation() const;
+
+private:
+  void Repack(unsigned int vertexCapacity, unsigned int indexCapacity);
+
+  VertexBufferLayout m_Layout;
+  std::unique_ptr<VertexBuffer> m_VertexBuffer;
+  std::unique_ptr<IndexBuffer> m_IndexBuffer;
+  std::unique_ptr<VertexArray> m_VAO;
+  RangeAllocator m_VertexRanges, m_IndexRanges;
+  std::vector<Mesh> m_Meshes; // By ID; removed entries have no indices
+  std::vector<unsigned int> m_FreeIDs;
+};
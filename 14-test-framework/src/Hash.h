@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// 64-bit FNV-1a. constexpr so that names can be hashed at compile time.
+constexpr uint64_t Fnv1a64(const char *data, size_t size,
+                           uint64_t hash = 14695981039346656037ull) {
+  for (size_t i = 0; i < size; i++) {
+    hash ^= (unsigned char)data[i];
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+inline uint64_t Fnv1a64(const std::string &text, uint64_t hash = 14695981039346656037ull) {
+  return Fnv1a64(text.data(), text.size(), hash);
+}
@@ -1,24 +1,50 @@
 #include "IndexBuffer.h"
 
 #include "Renderer.h"
+#include "RenderStats.h"
+
+#include <algorithm>
 
 IndexBuffer::IndexBuffer(const unsigned int *data, unsigned int count)
-: m_Count(count)  {
+: m_Count(count), m_Capacity(count)  {
   ASSERT(sizeof(unsigned int) == sizeof(GLuint));
   GLCall(glGenBuffers(1, &m_RendererID));
-  GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID));
+  GLState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
   GLCall(glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(unsigned int), data,
                       GL_STATIC_DRAW));
+  RenderStats::Get().BufferBytes += count * sizeof(unsigned int);
+}
+
+void IndexBuffer::SetCount(unsigned int count) {
+  ASSERT(count <= m_Capacity);
+  m_Count = count;
+}
+
+IndexBuffer::IndexBuffer(unsigned int capacity) : m_Count(0), m_Capacity(capacity) {
+  GLCall(glGenBuffers(1, &m_RendererID));
+  GLState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
+  GLCall(glBufferData(GL_ELEMENT_ARRAY_BUFFER, capacity * sizeof(unsigned int), nullptr,
+                      GL_DYNAMIC_DRAW));
 }
 
 IndexBuffer::~IndexBuffer() { 
+    GLState::OnDeleteBuffer(m_RendererID);
     GLCall(glDeleteBuffers(1, &m_RendererID)); 
 }
 
 void IndexBuffer::Bind() const {
-  GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID));
+  GLState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
 }
 
 void IndexBuffer::Unbind() const { 
-    GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0)); 
-}
\ No newline at end of file
+    GLState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0); 
+}
+
+void IndexBuffer::SetData(const unsigned int *data, unsigned int count, unsigned int offset) {
+  ASSERT(offset + count <= m_Capacity);
+  GLState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
+  GLCall(glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, offset * sizeof(unsigned int),
+                         count * sizeof(unsigned int), data));
+  m_Count = std::max(m_Count, offset + count);
+  RenderStats::Get().BufferBytes += count * sizeof(unsigned int);
+}
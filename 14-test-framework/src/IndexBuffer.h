@@ -4,13 +4,24 @@ class IndexBuffer {
 private:
   unsigned int m_RendererID;
   unsigned int m_Count;
+  unsigned int m_Capacity;
 
 public:
     IndexBuffer(const unsigned int* data, unsigned int count);
+    // Dynamic buffer with room for capacity indices, empty until SetData
+    IndexBuffer(unsigned int capacity);
     ~IndexBuffer();
 
+    // Overwrite count indices starting at index offset; the count grows to
+    // cover the highest index written
+    void SetData(const unsigned int* data, unsigned int count, unsigned int offset = 0);
+    // For owners that fill the buffer some other way, e.g. glCopyBufferSubData
+    void SetCount(unsigned int count);
+
     void Bind() const;
     void Unbind() const;
 
     inline unsigned int GetCount() const { return m_Count; }; 
+    inline unsigned int GetCapacity() const { return m_Capacity; }
+    inline unsigned int GetRendererID() const { return m_RendererID; }
 };
\ No newline at end of file
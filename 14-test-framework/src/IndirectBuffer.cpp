@@ -0,0 +1,47 @@
+#include "IndirectBuffer.h"
+
+#include "Renderer.h"
+#include "RenderStats.h"
+
+IndirectBuffer::IndirectBuffer(unsigned int maxCommands) : m_MaxCommands(maxCommands) {
+  static_assert(sizeof(DrawElementsIndirectCommand) == 5 * sizeof(GLuint),
+                "DrawElementsIndirectCommand must match the GL layout");
+  GLCall(glGenBuffers(1, &m_RendererID));
+  GLState::BindBuffer(GL_DRAW_INDIRECT_BUFFER, m_RendererID);
+  GLCall(glBufferData(GL_DRAW_INDIRECT_BUFFER,
+                      maxCommands * sizeof(DrawElementsIndirectCommand), nullptr,
+                      GL_DYNAMIC_DRAW));
+  m_Commands.reserve(maxCommands);
+}
+
+IndirectBuffer::~IndirectBuffer() {
+  GLState::OnDeleteBuffer(m_RendererID);
+  GLCall(glDeleteBuffers(1, &m_RendererID));
+}
+
+void IndirectBuffer::SetData(const DrawElementsIndirectCommand *commands, unsigned int count) {
+  ASSERT(count <= m_MaxCommands);
+  m_Commands.assign(commands, commands + count);
+  if (!IsSupported())
+    return; // Only the CPU copy is read
+  unsigned int size = count * sizeof(DrawElementsIndirectCommand);
+  GLState::BindBuffer(GL_DRAW_INDIRECT_BUFFER, m_RendererID);
+  GLCall(glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, size, commands));
+  RenderStats::Get().BufferBytes += size;
+}
+
+void IndirectBuffer::Bind() const {
+  GLState::BindBuffer(GL_DRAW_INDIRECT_BUFFER, m_RendererID);
+}
+
+void IndirectBuffer::Unbind() const {
+  GLState::BindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
+
+bool IndirectBuffer::IsSupported() {
+  return GLEW_VERSION_4_3 || GLEW_ARB_multi_draw_indirect;
+}
+
+bool IndirectBuffer::IsBaseInstanceSupported() {
+  return GLEW_VERSION_4_2 || GLEW_ARB_base_instance;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <vector>
+
+// One draw as glMultiDrawElementsIndirect reads it from the buffer; the
+// member order and sizes are fixed by the GL spec
+struct DrawElementsIndirectCommand {
+  unsigned int Count;         // Indices to draw
+  unsigned int InstanceCount;
+  unsigned int FirstIndex;    // Offset into the index buffer, in indices
+  int BaseVertex;             // Added to every index
+  unsigned int BaseInstance;  // First instance for per-instance attributes
+};
+
+// GL_DRAW_INDIRECT_BUFFER holding draw commands for Renderer::MultiDrawIndirect.
+// A CPU copy is kept so the renderer can issue the commands one by one on
+// drivers without multi-draw indirect.
+class IndirectBuffer {
+public:
+  IndirectBuffer(unsigned int maxCommands);
+  ~IndirectBuffer();
+
+  // Replace the commands; count must not exceed maxCommands
+  void SetData(const DrawElementsIndirectCommand *commands, unsigned int count);
+
+  void Bind() const;
+  void Unbind() const;
+
+  inline unsigned int GetCount() const { return m_Commands.size(); }
+  inline const std::vector<DrawElementsIndirectCommand> &GetCommands() const {
+    return m_Commands;
+  }
+
+  // glMultiDrawElementsIndirect, GL 4.3 or ARB_multi_draw_indirect
+  static bool IsSupported();
+  // Base instance in the per-command fallback, GL 4.2 or ARB_base_instance;
+  // without it the fallback moves the instanced attribute pointers instead
+  static bool IsBaseInstanceSupported();
+
+private:
+  unsigned int m_RendererID;
+  unsigned int m_MaxCommands;
+  std::vector<DrawElementsIndirectCommand> m_Commands;
+};
@@ -0,0 +1,189 @@
+#include "Mipmap.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MIPMAP_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace {
+// Kaiser-windowed sinc taps for a 2:1 reduction. Output pixel x sits between
+// source pixels 2x and 2x + 1; tap i reads source pixel 2x - 3 + i.
+const int KaiserTaps = 8;
+
+float BesselI0(float x) {
+  // Power series, converges quickly for the alpha used here
+  float sum = 1.0f, term = 1.0f;
+  for (int k = 1; k < 20; k++) {
+    term *= (x / (2.0f * k)) * (x / (2.0f * k));
+    sum += term;
+  }
+  return sum;
+}
+
+struct KaiserWeights {
+  float Weights[KaiserTaps];
+
+  KaiserWeights() {
+    const float alpha = 4.0f, radius = KaiserTaps / 2.0f;
+    const float pi = 3.14159265f;
+    float total = 0.0f;
+    for (int i = 0; i < KaiserTaps; i++) {
+      float distance = i - 3.5f; // From the output centre, in source pixels
+      float x = distance / 2.0f; // Sinc with a cutoff at the new Nyquist
+      float sinc = x == 0.0f ? 1.0f : std::sin(pi * x) / (pi * x);
+      float t = distance / radius;
+      float window = BesselI0(alpha * std::sqrt(std::max(0.0f, 1.0f - t * t))) / BesselI0(alpha);
+      Weights[i] = sinc * window;
+      total += Weights[i];
+    }
+    for (float &weight : Weights)
+      weight /= total;
+  }
+};
+
+const KaiserWeights s_Kaiser;
+
+void DownsampleBox(const unsigned char *src, int width, int height,
+                   unsigned char *dst, int dstWidth, int dstHeight) {
+  for (int y = 0; y < dstHeight; y++) {
+    const unsigned char *row0 = src + (size_t)(2 * y) * width * 4;
+    const unsigned char *row1 = src + (size_t)std::min(2 * y + 1, height - 1) * width * 4;
+    unsigned char *out = dst + (size_t)y * dstWidth * 4;
+    int x = 0;
+
+#ifdef MIPMAP_SSE2
+    // Two output pixels from four source pixels of each row per iteration
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rounding = _mm_set1_epi16(2);
+    for (; x + 2 <= dstWidth; x += 2) {
+      __m128i top = _mm_loadu_si128((const __m128i *)(row0 + x * 8));
+      __m128i bottom = _mm_loadu_si128((const __m128i *)(row1 + x * 8));
+      // Source pixels 0-1 and 2-3 as 16 bit channels, rows summed
+      __m128i left = _mm_add_epi16(_mm_unpacklo_epi8(top, zero), _mm_unpacklo_epi8(bottom, zero));
+      __m128i right = _mm_add_epi16(_mm_unpackhi_epi8(top, zero), _mm_unpackhi_epi8(bottom, zero));
+      // Add horizontal neighbours: the low half of each then holds a 2x2 sum
+      left = _mm_add_epi16(left, _mm_srli_si128(left, 8));
+      right = _mm_add_epi16(right, _mm_srli_si128(right, 8));
+      __m128i sums = _mm_unpacklo_epi64(left, right);
+      __m128i average = _mm_srli_epi16(_mm_add_epi16(sums, rounding), 2);
+      _mm_storel_epi64((__m128i *)(out + x * 4), _mm_packus_epi16(average, zero));
+    }
+#endif
+
+    for (; x < dstWidth; x++) {
+      int x0 = 2 * x, x1 = std::min(2 * x + 1, width - 1);
+      for (int c = 0; c < 4; c++) {
+        out[x * 4 + c] = (row0[x0 * 4 + c] + row0[x1 * 4 + c] + row1[x0 * 4 + c] +
+                          row1[x1 * 4 + c] + 2) >> 2;
+      }
+    }
+  }
+}
+
+// Separable: filter rows into a float image of dstWidth x height, then
+// columns into dst. Edges clamp.
+void DownsampleKaiser(const unsigned char *src, int width, int height,
+                      unsigned char *dst, int dstWidth, int dstHeight) {
+  std::vector<float> horizontal((size_t)dstWidth * height * 4);
+
+  for (int y = 0; y < height; y++) {
+    const unsigned char *row = src + (size_t)y * width * 4;
+    float *out = &horizontal[(size_t)y * dstWidth * 4];
+    for (int x = 0; x < dstWidth; x++) {
+#ifdef MIPMAP_SSE2
+      __m128 sum = _mm_setzero_ps();
+      for (int i = 0; i < KaiserTaps; i++) {
+        int sx = std::min(std::max(2 * x - 3 + i, 0), width - 1);
+        int texel;
+        std::copy(row + sx * 4, row + sx * 4 + 4, (unsigned char *)&texel);
+        __m128i channels = _mm_unpacklo_epi16(
+            _mm_unpacklo_epi8(_mm_cvtsi32_si128(texel), _mm_setzero_si128()),
+            _mm_setzero_si128());
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_cvtepi32_ps(channels),
+                                         _mm_set1_ps(s_Kaiser.Weights[i])));
+      }
+      _mm_storeu_ps(out + x * 4, sum);
+#else
+      for (int c = 0; c < 4; c++) {
+        float sum = 0.0f;
+        for (int i = 0; i < KaiserTaps; i++) {
+          int sx = std::min(std::max(2 * x - 3 + i, 0), width - 1);
+          sum += row[sx * 4 + c] * s_Kaiser.Weights[i];
+        }
+        out[x * 4 + c] = sum;
+      }
+#endif
+    }
+  }
+
+  for (int y = 0; y < dstHeight; y++) {
+    unsigned char *out = dst + (size_t)y * dstWidth * 4;
+    for (int x = 0; x < dstWidth; x++) {
+#ifdef MIPMAP_SSE2
+      __m128 sum = _mm_setzero_ps();
+      for (int i = 0; i < KaiserTaps; i++) {
+        int sy = std::min(std::max(2 * y - 3 + i, 0), height - 1);
+        __m128 texel = _mm_loadu_ps(&horizontal[((size_t)sy * dstWidth + x) * 4]);
+        sum = _mm_add_ps(sum, _mm_mul_ps(texel, _mm_set1_ps(s_Kaiser.Weights[i])));
+      }
+      // Round, then saturate through the packs (the sinc lobes can overshoot)
+      __m128i rounded = _mm_cvtps_epi32(sum);
+      __m128i packed = _mm_packus_epi16(_mm_packs_epi32(rounded, rounded), _mm_setzero_si128());
+      int texel = _mm_cvtsi128_si32(packed);
+      std::copy((unsigned char *)&texel, (unsigned char *)&texel + 4, out + x * 4);
+#else
+      for (int c = 0; c < 4; c++) {
+        float sum = 0.0f;
+        for (int i = 0; i < KaiserTaps; i++) {
+          int sy = std::min(std::max(2 * y - 3 + i, 0), height - 1);
+          sum += horizontal[((size_t)sy * dstWidth + x) * 4 + c] * s_Kaiser.Weights[i];
+        }
+        out[x * 4 + c] = (unsigned char)std::min(std::max(std::lround(sum), 0L), 255L);
+      }
+#endif
+    }
+  }
+}
+} // namespace
+
+int Mipmap::GetLevelCount(int width, int height) {
+  int levels = 1;
+  while (width > 1 || height > 1) {
+    width = std::max(width / 2, 1);
+    height = std::max(height / 2, 1);
+    levels++;
+  }
+  return levels;
+}
+
+void Mipmap::Downsample(const unsigned char *src, int width, int height,
+                        unsigned char *dst, Filter filter) {
+  int dstWidth = std::max(width / 2, 1), dstHeight = std::max(height / 2, 1);
+  if (filter == Filter::Kaiser) {
+    DownsampleKaiser(src, width, height, dst, dstWidth, dstHeight);
+  } else {
+    DownsampleBox(src, width, height, dst, dstWidth, dstHeight);
+  }
+}
+
+std::vector<Mipmap::Level> Mipmap::BuildChain(const unsigned char *pixels, int width,
+                                              int height, Filter filter) {
+  std::vector<Level> levels;
+  const unsigned char *src = pixels;
+  while (width > 1 || height > 1) {
+    Level level;
+    level.Width = std::max(width / 2, 1);
+    level.Height = std::max(height / 2, 1);
+    level.Pixels.resize((size_t)level.Width * level.Height * 4);
+    Downsample(src, width, height, level.Pixels.data(), filter);
+    levels.push_back(std::move(level));
+
+    src = levels.back().Pixels.data();
+    width = levels.back().Width;
+    height = levels.back().Height;
+  }
+  return levels;
+}
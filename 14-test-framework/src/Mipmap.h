@@ -0,0 +1,30 @@
+#pragma once
+
+#include <vector>
+
+// CPU mip chain generation for RGBA8 images, for baking offline or when the
+// driver's glGenerateMipmap quality isn't good enough. Uses SSE2 where the
+// compiler targets it, scalar code otherwise.
+class Mipmap {
+public:
+  enum class Filter {
+    Box,   // 2x2 average, what most drivers do
+    Kaiser // 8-tap Kaiser-windowed sinc: sharper, less aliasing, slower
+  };
+
+  struct Level {
+    int Width, Height;
+    std::vector<unsigned char> Pixels;
+  };
+
+  // Levels needed to reach 1x1, including the full size one
+  static int GetLevelCount(int width, int height);
+
+  // Writes the next level down (each side halved, at least 1) into dst
+  static void Downsample(const unsigned char *src, int width, int height,
+                         unsigned char *dst, Filter filter = Filter::Box);
+
+  // Every level below the given one, largest first
+  static std::vector<Level> BuildChain(const unsigned char *pixels, int width,
+                                       int height, Filter filter = Filter::Box);
+};
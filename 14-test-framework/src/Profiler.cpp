@@ -0,0 +1,256 @@
+#include "Profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+#include "imgui/imgui.h"
+
+std::mutex Profiler::s_ThreadsMutex;
+std::vector<Profiler::ThreadBuffer *> Profiler::s_Threads;
+std::vector<Profiler::ThreadBuffer *> Profiler::s_FreeBuffers;
+
+static const std::chrono::steady_clock::time_point s_Epoch = std::chrono::steady_clock::now();
+
+// Flame view state, main thread only
+struct ProfilerLane {
+  std::string Name;
+  std::vector<Profiler::Zone> Zones;
+  uint32_t MaxDepth;
+};
+
+static const int FrameHistorySize = 240;
+static float s_FrameHistory[FrameHistorySize] = {};
+static int s_FrameHistoryOffset = 0;
+static int64_t s_FrameStart = 0;
+static int64_t s_ViewStart = 0, s_ViewEnd = 0;
+static std::vector<ProfilerLane> s_Lanes;
+static bool s_ViewVisible = false; // Only collect zones while someone looks
+static bool s_Frozen = false;
+static float s_FreezeAboveMs = 0.0f; // 0 = never freeze automatically
+
+int64_t Profiler::Now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now() - s_Epoch).count();
+}
+
+struct Profiler::ThreadBufferOwner {
+  ThreadBuffer *Buffer = nullptr;
+
+  ~ThreadBufferOwner() {
+    if (!Buffer)
+      return;
+    std::lock_guard<std::mutex> lock(s_ThreadsMutex);
+    s_FreeBuffers.push_back(Buffer);
+  }
+};
+
+Profiler::ThreadBuffer &Profiler::GetThreadBuffer() {
+  thread_local ThreadBufferOwner owner;
+  if (!owner.Buffer) {
+    std::lock_guard<std::mutex> lock(s_ThreadsMutex);
+    if (!s_FreeBuffers.empty()) {
+      // Committed keeps counting up, so concurrent readers stay consistent
+      owner.Buffer = s_FreeBuffers.back();
+      s_FreeBuffers.pop_back();
+      owner.Buffer->Depth = 0;
+    } else {
+      owner.Buffer = new ThreadBuffer();
+      owner.Buffer->ThreadIndex = s_Threads.size();
+      s_Threads.push_back(owner.Buffer);
+    }
+    owner.Buffer->Name = "Thread " + std::to_string(owner.Buffer->ThreadIndex);
+  }
+  return *owner.Buffer;
+}
+
+std::vector<Profiler::ThreadBuffer *> Profiler::GetThreadBuffers() {
+  std::lock_guard<std::mutex> lock(s_ThreadsMutex);
+  return s_Threads;
+}
+
+void Profiler::SetThreadName(const char *name) {
+  ThreadBuffer &buffer = GetThreadBuffer();
+  std::lock_guard<std::mutex> lock(s_ThreadsMutex);
+  buffer.Name = name;
+}
+
+uint32_t Profiler::BeginZone() {
+  return GetThreadBuffer().Depth++;
+}
+
+void Profiler::EndZone(const char *name, int64_t start, uint32_t depth) {
+  int64_t end = Now();
+  ThreadBuffer &buffer = GetThreadBuffer();
+  uint64_t index = buffer.Committed.load(std::memory_order_relaxed);
+  buffer.Zones[index & (RingSize - 1)] = {name, start, end, depth};
+  buffer.Depth = depth;
+  buffer.Committed.store(index + 1, std::memory_order_release);
+}
+
+void Profiler::CopyZones(ThreadBuffer &buffer, int64_t start, int64_t end,
+                         std::vector<Zone> &zones) {
+  uint64_t committed = buffer.Committed.load(std::memory_order_acquire);
+  uint64_t oldest = committed > RingSize ? committed - RingSize : 0;
+
+  // Zones are committed in order of their end time, so walk back from the
+  // newest until they end before the range
+  std::vector<Zone> found;
+  std::vector<uint64_t> indices;
+  uint64_t index = committed;
+  for (; index > oldest; index--) {
+    const Zone &zone = buffer.Zones[(index - 1) & (RingSize - 1)];
+    if (zone.End < start)
+      break;
+    if (zone.Start < end) {
+      found.push_back(zone);
+      indices.push_back(index - 1);
+    }
+  }
+
+  // Drop whatever the writer overwrote while we were copying, including the
+  // slot it may be writing right now. found is newest first.
+  uint64_t after = buffer.Committed.load(std::memory_order_acquire);
+  uint64_t valid = after + 1 > RingSize ? after + 1 - RingSize : 0;
+  size_t keep = 0;
+  while (keep < found.size() && indices[keep] >= valid)
+    keep++;
+  found.resize(keep);
+
+  zones.insert(zones.end(), found.rbegin(), found.rend());
+}
+
+void Profiler::EndFrame() {
+  int64_t now = Now();
+  float frameMs = (now - s_FrameStart) / 1e6f;
+  s_FrameHistory[s_FrameHistoryOffset] = frameMs;
+  s_FrameHistoryOffset = (s_FrameHistoryOffset + 1) % FrameHistorySize;
+
+  if (s_ViewVisible && !s_Frozen) {
+    s_ViewStart = s_FrameStart;
+    s_ViewEnd = now;
+    s_Lanes.clear();
+    for (ThreadBuffer *buffer : GetThreadBuffers()) {
+      ProfilerLane lane;
+      CopyZones(*buffer, s_ViewStart, s_ViewEnd, lane.Zones);
+      if (lane.Zones.empty())
+        continue;
+      {
+        std::lock_guard<std::mutex> lock(s_ThreadsMutex);
+        lane.Name = buffer->Name;
+      }
+      lane.MaxDepth = 0;
+      for (const Zone &zone : lane.Zones)
+        lane.MaxDepth = std::max(lane.MaxDepth, zone.Depth);
+      s_Lanes.push_back(std::move(lane));
+    }
+    if (s_FreezeAboveMs > 0.0f && frameMs > s_FreezeAboveMs)
+      s_Frozen = true;
+  }
+  s_ViewVisible = false;
+  s_FrameStart = now;
+}
+
+static std::string JsonEscape(const std::string &value) {
+  std::string out;
+  for (char c : value) {
+    if (c == '"' || c == '\\')
+      out += '\\';
+    out += c;
+  }
+  return out;
+}
+
+bool Profiler::WriteChromeTrace(const std::string &path) {
+  std::ofstream out(path);
+  if (!out) {
+    std::cout << "Error: could not open " << path << std::endl;
+    return false;
+  }
+
+  out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+  bool first = true;
+  std::vector<Zone> zones;
+  for (ThreadBuffer *buffer : GetThreadBuffers()) {
+    std::string name;
+    {
+      std::lock_guard<std::mutex> lock(s_ThreadsMutex);
+      name = buffer->Name;
+    }
+    out << (first ? "\n" : ",\n")
+        << "{\"ph\": \"M\", \"name\": \"thread_name\", \"pid\": 0, \"tid\": "
+        << buffer->ThreadIndex << ", \"args\": {\"name\": \"" << JsonEscape(name) << "\"}}";
+    first = false;
+
+    zones.clear();
+    CopyZones(*buffer, INT64_MIN, INT64_MAX, zones);
+    for (const Zone &zone : zones) {
+      // Timestamps are in microseconds
+      char times[64];
+      std::snprintf(times, sizeof(times), "\"ts\": %.3f, \"dur\": %.3f",
+                    zone.Start / 1e3, (zone.End - zone.Start) / 1e3);
+      out << ",\n{\"ph\": \"X\", \"name\": \"" << JsonEscape(zone.Name)
+          << "\", \"pid\": 0, \"tid\": " << buffer->ThreadIndex << ", " << times << "}";
+    }
+  }
+  out << "\n]}\n";
+
+  std::cout << "Status: Wrote profiler trace to " << path << std::endl;
+  return true;
+}
+
+void Profiler::OnImGuiRender() {
+  s_ViewVisible = true;
+
+  ImGui::Begin("Profiler");
+
+  float maxMs = 0.0f;
+  for (float ms : s_FrameHistory)
+    maxMs = std::max(maxMs, ms);
+  char overlay[32];
+  std::snprintf(overlay, sizeof(overlay), "max %.2f ms", maxMs);
+  ImGui::PlotLines("Frame ms", s_FrameHistory, FrameHistorySize, s_FrameHistoryOffset,
+                   overlay, 0.0f, maxMs, ImVec2(0, 60));
+
+  ImGui::Checkbox("Freeze", &s_Frozen);
+  ImGui::SameLine();
+  ImGui::SliderFloat("Freeze above (ms)", &s_FreezeAboveMs, 0.0f, 100.0f);
+  if (ImGui::Button("Export Chrome trace")) {
+    WriteChromeTrace("trace.json");
+  }
+  ImGui::Text("Showing %.3f ms", (s_ViewEnd - s_ViewStart) / 1e6f);
+
+  // One lane per thread, one row per nesting level
+  ImDrawList *drawList = ImGui::GetWindowDrawList();
+  const float rowHeight = ImGui::GetTextLineHeight() + 4.0f;
+  float width = ImGui::GetContentRegionAvail().x;
+  double scale = s_ViewEnd > s_ViewStart ? width / (double)(s_ViewEnd - s_ViewStart) : 0.0;
+  for (const ProfilerLane &lane : s_Lanes) {
+    ImGui::Text("%s", lane.Name.c_str());
+    ImVec2 origin = ImGui::GetCursorScreenPos();
+    for (const Zone &zone : lane.Zones) {
+      float x0 = origin.x + (float)(std::max(zone.Start - s_ViewStart, (int64_t)0) * scale);
+      float x1 = origin.x + (float)(std::min(zone.End - s_ViewStart, s_ViewEnd - s_ViewStart) * scale);
+      x1 = std::max(x1, x0 + 1.0f);
+      ImVec2 min(x0, origin.y + zone.Depth * rowHeight);
+      ImVec2 max(x1, min.y + rowHeight - 1.0f);
+
+      // Stable colour per zone name
+      float hue = ((uintptr_t)zone.Name * 2654435761u % 360) / 360.0f;
+      drawList->AddRectFilled(min, max, ImColor::HSV(hue, 0.5f, 0.7f));
+      if (x1 - x0 > 20.0f) {
+        drawList->PushClipRect(min, max, true);
+        drawList->AddText(ImVec2(x0 + 2.0f, min.y + 2.0f), IM_COL32_WHITE, zone.Name);
+        drawList->PopClipRect();
+      }
+      if (ImGui::IsMouseHoveringRect(min, max)) {
+        ImGui::SetTooltip("%s: %.3f ms", zone.Name, (zone.End - zone.Start) / 1e6f);
+      }
+    }
+    ImGui::Dummy(ImVec2(width, (lane.MaxDepth + 1) * rowHeight));
+  }
+
+  ImGui::End();
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Scoped CPU profiling zones:
+//
+//   void Renderer::Draw(...) {
+//     PROFILE_FUNCTION();
+//     { PROFILE_SCOPE("Upload"); ... }
+//   }
+//
+// Names must be string literals (or otherwise outlive the profiler). Each
+// thread records finished zones into its own ring buffer without locking;
+// the oldest zones are overwritten once a ring is full. Disabled with
+// -DPROFILER=OFF.
+#ifdef PROFILER_ENABLED
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#else
+#define PROFILE_SCOPE(name)
+#endif
+#define PROFILE_FUNCTION() PROFILE_SCOPE(__func__)
+
+class Profiler {
+public:
+  struct Zone {
+    const char *Name;
+    int64_t Start, End; // Nanoseconds since the profiler started
+    uint32_t Depth;     // Nesting level on its thread
+  };
+
+  // Nanoseconds since the profiler started
+  static int64_t Now();
+
+  // Label the calling thread in the trace and flame view
+  static void SetThreadName(const char *name);
+
+  // Mark the end of a frame; call once per frame from the main thread
+  static void EndFrame();
+
+  // Write every zone still held in the rings as Chrome trace_event JSON,
+  // viewable in chrome://tracing or ui.perfetto.dev
+  static bool WriteChromeTrace(const std::string &path);
+
+  // Frame time history and a flame view of the last (or frozen) frame
+  static void OnImGuiRender();
+
+  // Used by ProfileScope
+  static uint32_t BeginZone();
+  static void EndZone(const char *name, int64_t start, uint32_t depth);
+
+private:
+  static const uint32_t RingSize = 16384; // Zones per thread, power of two
+
+  // Written only by its thread; readers copy zones and then check that the
+  // writer hasn't lapped them
+  struct ThreadBuffer {
+    Zone Zones[RingSize];
+    std::atomic<uint64_t> Committed{0};
+    uint32_t Depth = 0;
+    std::string Name;
+    uint32_t ThreadIndex;
+  };
+
+  // Thread-local; returns the buffer to s_FreeBuffers when its thread exits
+  struct ThreadBufferOwner;
+
+  static ThreadBuffer &GetThreadBuffer();
+  // Zones of one thread overlapping [start, end), oldest first
+  static void CopyZones(ThreadBuffer &buffer, int64_t start, int64_t end,
+                        std::vector<Zone> &zones);
+  static std::vector<ThreadBuffer *> GetThreadBuffers();
+
+  // Buffers are never freed so zones from finished threads can be exported.
+  // A new thread takes over a finished thread's buffer (and its older zones,
+  // now under the new thread's name) before another one is allocated.
+  static std::mutex s_ThreadsMutex;
+  static std::vector<ThreadBuffer *> s_Threads;
+  static std::vector<ThreadBuffer *> s_FreeBuffers;
+};
+
+class ProfileScope {
+public:
+  ProfileScope(const char *name)
+      : m_Name(name), m_Depth(Profiler::BeginZone()), m_Start(Profiler::Now()) {}
+  ~ProfileScope() { Profiler::EndZone(m_Name, m_Start, m_Depth); }
+
+private:
+  const char *m_Name;
+  uint32_t m_Depth;
+  int64_t m_Start;
+};
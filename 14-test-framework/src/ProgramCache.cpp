@@ -0,0 +1,137 @@
+#include "ProgramCache.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include "Hash.h"
+#include "Renderer.h"
+
+namespace {
+const uint32_t Magic = 0x42504C47; // "GLPB"
+
+struct Header {
+  uint32_t Magic;
+  uint32_t Format;
+  uint64_t Key;
+  uint32_t Length;
+};
+
+std::string s_Directory = "shadercache";
+
+uint64_t ComputeKey(const std::string &vertexSource,
+                    const std::string &fragmentSource) {
+  uint64_t key = Fnv1a64(vertexSource);
+  key = Fnv1a64(fragmentSource, key);
+  for (GLenum name : {GL_VENDOR, GL_RENDERER, GL_VERSION}) {
+    GLCall(const char *value = (const char *)glGetString(name));
+    if (value) {
+      key = Fnv1a64(value, std::char_traits<char>::length(value), key);
+    }
+  }
+  return key;
+}
+
+bool IsFormatSupported(GLenum format) {
+  int count = 0;
+  GLCall(glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &count));
+  std::vector<int> formats(count);
+  if (count > 0) {
+    GLCall(glGetIntegerv(GL_PROGRAM_BINARY_FORMATS, formats.data()));
+  }
+  return std::find(formats.begin(), formats.end(), (int)format) != formats.end();
+}
+} // namespace
+
+bool ProgramCache::IsSupported() {
+  static int supported = -1;
+  if (supported < 0) {
+    int count = 0;
+    if (GLEW_VERSION_4_1 || GLEW_ARB_get_program_binary) {
+      GLCall(glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &count));
+    }
+    // Some drivers expose the entry points but no formats
+    supported = count > 0;
+  }
+  return supported;
+}
+
+void ProgramCache::SetDirectory(const std::string &directory) {
+  s_Directory = directory;
+}
+
+std::string ProgramCache::GetPath(uint64_t key) {
+  std::stringstream ss;
+  ss << s_Directory << "/" << std::hex << std::setfill('0') << std::setw(16)
+     << key << ".bin";
+  return ss.str();
+}
+
+unsigned int ProgramCache::Load(const std::string &vertexSource,
+                                const std::string &fragmentSource) {
+  if (!IsSupported()) {
+    return 0;
+  }
+
+  uint64_t key = ComputeKey(vertexSource, fragmentSource);
+  std::ifstream stream(GetPath(key), std::ios::binary);
+  Header header;
+  if (!stream.read((char *)&header, sizeof(header)) || header.Magic != Magic ||
+      header.Key != key) {
+    return 0;
+  }
+
+  std::vector<char> binary(header.Length);
+  if (!stream.read(binary.data(), binary.size()) || !IsFormatSupported(header.Format)) {
+    return 0;
+  }
+
+  GLCall(unsigned int program = glCreateProgram());
+  GLCall(glProgramBinary(program, header.Format, binary.data(), header.Length));
+
+  // The driver may still reject a binary it produced, e.g. after an update
+  // that kept the version string
+  int linked;
+  GLCall(glGetProgramiv(program, GL_LINK_STATUS, &linked));
+  if (linked == GL_FALSE) {
+    std::cout << "Status: Discarding stale program binary" << std::endl;
+    GLCall(glDeleteProgram(program));
+    return 0;
+  }
+  return program;
+}
+
+void ProgramCache::Store(unsigned int program, const std::string &vertexSource,
+                         const std::string &fragmentSource) {
+  if (!IsSupported()) {
+    return;
+  }
+
+  int linked, length = 0;
+  GLCall(glGetProgramiv(program, GL_LINK_STATUS, &linked));
+  GLCall(glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length));
+  if (linked == GL_FALSE || length <= 0) {
+    return;
+  }
+
+  std::vector<char> binary(length);
+  Header header;
+  GLCall(glGetProgramBinary(program, length, &length, &header.Format, binary.data()));
+  header.Magic = Magic;
+  header.Key = ComputeKey(vertexSource, fragmentSource);
+  header.Length = length;
+
+  std::error_code error;
+  std::filesystem::create_directories(s_Directory, error);
+  std::ofstream stream(GetPath(header.Key), std::ios::binary);
+  stream.write((const char *)&header, sizeof(header));
+  stream.write(binary.data(), length);
+  if (!stream) {
+    std::cout << "Warning: Failed to write program binary to " << s_Directory << std::endl;
+  }
+}
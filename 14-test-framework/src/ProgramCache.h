@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// On-disk cache of linked program binaries (glGetProgramBinary). Entries are
+// keyed by a hash of the shader sources and the driver vendor, renderer and
+// version strings, so an edited shader or a driver update is simply a miss.
+class ProgramCache {
+public:
+  // True if the context can save and load program binaries
+  static bool IsSupported();
+
+  // Returns a linked program built from the cached binary, or 0 on a miss
+  static unsigned int Load(const std::string &vertexSource,
+                           const std::string &fragmentSource);
+
+  // Save a linked program. It should have been linked with
+  // GL_PROGRAM_BINARY_RETRIEVABLE_HINT set.
+  static void Store(unsigned int program, const std::string &vertexSource,
+                    const std::string &fragmentSource);
+
+  static void SetDirectory(const std::string &directory);
+
+private:
+  static std::string GetPath(uint64_t key);
+};
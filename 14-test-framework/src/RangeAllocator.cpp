@@ -0,0 +1,65 @@
+#include "RangeAllocator.h"
+
+#include <iterator>
+
+RangeAllocator::RangeAllocator(unsigned int capacity) { Reset(capacity); }
+
+unsigned int RangeAllocator::Allocate(unsigned int size) {
+  auto fit = m_BySize.lower_bound(size);
+  if (size == 0 || fit == m_BySize.end())
+    return Invalid;
+
+  unsigned int offset = fit->second;
+  unsigned int rangeSize = fit->first;
+  Erase(m_ByOffset.find(offset));
+  if (rangeSize > size)
+    Insert(offset + size, rangeSize - size);
+  return offset;
+}
+
+void RangeAllocator::Free(unsigned int offset, unsigned int size) {
+  if (size == 0)
+    return;
+
+  auto next = m_ByOffset.lower_bound(offset);
+  if (next != m_ByOffset.begin()) {
+    auto prev = std::prev(next);
+    if (prev->first + prev->second == offset) {
+      offset = prev->first;
+      size += prev->second;
+      Erase(prev);
+    }
+  }
+  if (next != m_ByOffset.end() && offset + size == next->first) {
+    size += next->second;
+    Erase(next);
+  }
+  Insert(offset, size);
+}
+
+void RangeAllocator::Reset(unsigned int capacity, unsigned int used) {
+  m_Capacity = capacity;
+  m_FreeTotal = 0;
+  m_ByOffset.clear();
+  m_BySize.clear();
+  if (used < capacity)
+    Insert(used, capacity - used);
+}
+
+void RangeAllocator::Insert(unsigned int offset, unsigned int size) {
+  m_ByOffset[offset] = size;
+  m_BySize.insert({size, offset});
+  m_FreeTotal += size;
+}
+
+void RangeAllocator::Erase(std::map<unsigned int, unsigned int>::iterator range) {
+  auto sized = m_BySize.equal_range(range->second);
+  for (auto it = sized.first; it != sized.second; ++it) {
+    if (it->second == range->first) {
+      m_BySize.erase(it);
+      break;
+    }
+  }
+  m_FreeTotal -= range->second;
+  m_ByOffset.erase(range);
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <map>
+
+// Best-fit allocator over [0, capacity) in whatever unit the caller counts
+// in (vertices, indices). Free ranges are indexed by offset, to merge
+// neighbours on Free, and by size, to find the smallest range that fits.
+class RangeAllocator {
+public:
+  static const unsigned int Invalid = 0xFFFFFFFF;
+
+  RangeAllocator(unsigned int capacity = 0);
+
+  // Start of a range of size units, or Invalid if no free range is that large
+  unsigned int Allocate(unsigned int size);
+  // Return a range handed out by Allocate
+  void Free(unsigned int offset, unsigned int size);
+  // Forget all allocations, then treat [0, used) as allocated
+  void Reset(unsigned int capacity, unsigned int used = 0);
+
+  inline unsigned int GetCapacity() const { return m_Capacity; }
+  inline unsigned int GetFree() const { return m_FreeTotal; }
+  inline unsigned int GetLargestFree() const {
+    return m_BySize.empty() ? 0 : m_BySize.rbegin()->first;
+  }
+  inline unsigned int GetFreeRangeCount() const { return m_ByOffset.size(); }
+  // One past the last allocated unit, 0 when nothing is allocated
+  inline unsigned int GetEnd() const {
+    if (m_ByOffset.empty())
+      return m_Capacity;
+    auto last = m_ByOffset.rbegin();
+    return last->first + last->second == m_Capacity ? last->first : m_Capacity;
+  }
+
+private:
+  void Insert(unsigned int offset, unsigned int size);
+  void Erase(std::map<unsigned int, unsigned int>::iterator range);
+
+  unsigned int m_Capacity, m_FreeTotal;
+  std::map<unsigned int, unsigned int> m_ByOffset;     // offset -> size
+  std::multimap<unsigned int, unsigned int> m_BySize;  // size -> offset
+};
@@ -0,0 +1,150 @@
+#include "RenderQueue.h"
+
+#include <cstring>
+
+#include "Profiler.h"
+
+namespace {
+// Non-negative floats compare the same as their bit patterns
+uint32_t DepthBits(float depth) {
+  if (!(depth > 0.0f))
+    return 0; // Negative, zero and NaN all sort first
+  uint32_t bits;
+  std::memcpy(&bits, &depth, sizeof(bits));
+  return bits;
+}
+} // namespace
+
+uint64_t RenderQueue::MakeKey(int pass, bool translucent, unsigned int shader,
+                              unsigned int texture, float depth) {
+  uint64_t key = (uint64_t)(pass & (MaxPasses - 1)) << 60;
+  uint64_t state = ((uint64_t)(shader & 0xFFF) << 12) | (texture & 0xFFF);
+  uint64_t distance = DepthBits(depth);
+  if (translucent) {
+    // Farthest first so blending composites correctly
+    key |= 1ull << 59;
+    key |= (uint64_t)(~distance & 0xFFFFFFFF) << 27;
+    key |= state << 3;
+  } else {
+    key |= state << 35;
+    key |= distance << 3;
+  }
+  return key;
+}
+
+void RenderQueue::Submit(const DrawItem &item, int pass, bool translucent, float depth) {
+  unsigned int shader = item.Program ? item.Program->GetRendererID() : 0;
+  unsigned int texture = item.Tex ? item.Tex->GetRendererID() : 0;
+  m_Entries.push_back({MakeKey(pass, translucent, shader, texture, depth),
+                       (uint32_t)m_Commands.size()});
+  m_Commands.push_back({item, (uint32_t)m_Uniforms.size(), 0});
+}
+
+RenderQueue::UniformValue &RenderQueue::AddUniform(UniformValue::Type type, int location) {
+  ASSERT(!m_Commands.empty()); // Uniforms belong to the last submitted draw
+  m_Commands.back().UniformCount++;
+  m_Uniforms.emplace_back();
+  UniformValue &value = m_Uniforms.back();
+  value.ValueType = type;
+  value.Location = location;
+  return value;
+}
+
+void RenderQueue::SetUniform(Uniform<int> uniform, int value) {
+  std::memcpy(AddUniform(UniformValue::Type::Int, uniform.Location).Data, &value,
+              sizeof(value));
+}
+
+void RenderQueue::SetUniform(Uniform<float> uniform, float value) {
+  AddUniform(UniformValue::Type::Float, uniform.Location).Data[0] = value;
+}
+
+void RenderQueue::SetUniform(Uniform<glm::vec4> uniform, const glm::vec4 &value) {
+  std::memcpy(AddUniform(UniformValue::Type::Vec4, uniform.Location).Data, &value[0],
+              sizeof(float) * 4);
+}
+
+void RenderQueue::SetUniform(Uniform<glm::mat4> uniform, const glm::mat4 &value) {
+  std::memcpy(AddUniform(UniformValue::Type::Mat4, uniform.Location).Data, &value[0][0],
+              sizeof(float) * 16);
+}
+
+void RenderQueue::Sort() {
+  PROFILE_SCOPE("RenderQueue::Sort");
+  size_t count = m_Entries.size();
+  // One read pass builds the histograms of all eight bytes
+  uint32_t histograms[8][256] = {};
+  for (const SortEntry &entry : m_Entries)
+    for (int byte = 0; byte < 8; byte++)
+      histograms[byte][(entry.Key >> (byte * 8)) & 0xFF]++;
+
+  m_Scratch.resize(count);
+  for (int byte = 0; byte < 8; byte++) {
+    uint32_t *histogram = histograms[byte];
+    int shift = byte * 8;
+    // Every key has the same value here, so this pass would not move anything
+    if (histogram[(m_Entries[0].Key >> shift) & 0xFF] == count)
+      continue;
+
+    uint32_t offset = 0;
+    for (int bucket = 0; bucket < 256; bucket++) {
+      uint32_t size = histogram[bucket];
+      histogram[bucket] = offset;
+      offset += size;
+    }
+    for (const SortEntry &entry : m_Entries)
+      m_Scratch[histogram[(entry.Key >> shift) & 0xFF]++] = entry;
+    m_Entries.swap(m_Scratch);
+  }
+}
+
+void RenderQueue::Flush(const Renderer &renderer, bool sort) {
+  PROFILE_SCOPE("RenderQueue::Flush");
+  if (sort && m_Entries.size() > 1) {
+    Sort();
+  }
+
+  for (const SortEntry &entry : m_Entries) {
+    const Command &command = m_Commands[entry.Command];
+    const DrawItem &item = command.Item;
+    item.Program->Bind();
+    for (uint32_t i = 0; i < command.UniformCount; i++) {
+      const UniformValue &value = m_Uniforms[command.FirstUniform + i];
+      switch (value.ValueType) {
+      case UniformValue::Type::Int: {
+        int v;
+        std::memcpy(&v, value.Data, sizeof(v));
+        item.Program->SetUniform(Uniform<int>{value.Location}, v);
+        break;
+      }
+      case UniformValue::Type::Float:
+        item.Program->SetUniform(Uniform<float>{value.Location}, value.Data[0]);
+        break;
+      case UniformValue::Type::Vec4:
+        item.Program->SetUniform(Uniform<glm::vec4>{value.Location},
+                                 glm::vec4(value.Data[0], value.Data[1], value.Data[2],
+                                           value.Data[3]));
+        break;
+      case UniformValue::Type::Mat4: {
+        glm::mat4 matrix;
+        std::memcpy(&matrix[0][0], value.Data, sizeof(value.Data));
+        item.Program->SetUniform(Uniform<glm::mat4>{value.Location}, matrix);
+        break;
+      }
+      }
+    }
+    if (item.Tex) {
+      item.Tex->Bind(0);
+    }
+    unsigned int count = item.Count ? item.Count : item.IBO->GetCount();
+    if (item.InstanceCount == 1) {
+      renderer.Draw(*item.VAO, *item.IBO, *item.Program, count, item.BaseVertex);
+    } else {
+      renderer.DrawInstanced(*item.VAO, *item.IBO, *item.Program, item.InstanceCount);
+    }
+  }
+
+  m_Commands.clear();
+  m_Uniforms.clear();
+  m_Entries.clear();
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "Renderer.h"
+#include "Texture.h"
+
+// One deferred indexed draw. The objects must outlive the next Flush.
+struct DrawItem {
+  Shader *Program = nullptr;
+  const VertexArray *VAO = nullptr;
+  const IndexBuffer *IBO = nullptr;
+  const Texture *Tex = nullptr; // Bound to slot 0 if set
+  unsigned int Count = 0;       // Indices to draw, 0 for the whole buffer
+  int BaseVertex = 0;
+  unsigned int InstanceCount = 1; // Above 1 draws the whole index buffer
+};
+
+// Collects draws during a frame and issues them at Flush in the order of a
+// 64 bit sort key rather than the order they were submitted. Within a pass,
+// opaque draws are grouped by shader, then by texture, then drawn front to
+// back. Translucent draws follow them back to front. GLState drops the binds
+// that the grouping makes redundant.
+//
+// Key layout, most significant bits first:
+//   opaque      pass:4 | 0 | shader:12 | texture:12 | depth:32 | 0:3
+//   translucent pass:4 | 1 | ~depth:32 | shader:12 | texture:12 | 0:3
+// Shader and texture are the GL object IDs modulo 4096. A collision only
+// costs a bind, never a wrong draw.
+class RenderQueue {
+public:
+  static const int MaxPasses = 16;
+
+  // depth is the distance from the camera, anything >= 0
+  void Submit(const DrawItem &item, int pass = 0, bool translucent = false,
+              float depth = 0.0f);
+
+  // Per-draw uniforms, set on the most recently submitted draw just before
+  // it is issued
+  void SetUniform(Uniform<int> uniform, int value);
+  void SetUniform(Uniform<float> uniform, float value);
+  void SetUniform(Uniform<glm::vec4> uniform, const glm::vec4 &value);
+  void SetUniform(Uniform<glm::mat4> uniform, const glm::mat4 &value);
+
+  // Sorts and issues every draw submitted since the last flush. Without
+  // sorting, draws go out in submission order, for comparison.
+  void Flush(const Renderer &renderer, bool sort = true);
+
+  inline size_t GetSize() const { return m_Commands.size(); }
+
+  static uint64_t MakeKey(int pass, bool translucent, unsigned int shader,
+                          unsigned int texture, float depth);
+
+private:
+  struct Command {
+    DrawItem Item;
+    uint32_t FirstUniform, UniformCount;
+  };
+
+  struct UniformValue {
+    enum class Type { Int, Float, Vec4, Mat4 } ValueType;
+    int Location;
+    float Data[16]; // Int values are stored in Data[0]'s bits
+  };
+
+  struct SortEntry {
+    uint64_t Key;
+    uint32_t Command;
+  };
+
+  UniformValue &AddUniform(UniformValue::Type type, int location);
+  // LSD radix sort on the keys, 8 bits per pass, skipping bytes that every
+  // key shares. Stable, so equal keys keep their submission order.
+  void Sort();
+
+  std::vector<Command> m_Commands;
+  std::vector<UniformValue> m_Uniforms;
+  std::vector<SortEntry> m_Entries, m_Scratch;
+};
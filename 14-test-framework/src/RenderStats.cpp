@@ -0,0 +1,30 @@
+#include "RenderStats.h"
+
+#include "GLState.h"
+
+#include "imgui/imgui.h"
+
+RenderStats RenderStats::s_Current;
+RenderStats RenderStats::s_LastFrame;
+
+const RenderStats &RenderStats::EndFrame() {
+  const GLState::Counters &counters = GLState::GetCounters();
+  s_Current.StateChanges = counters.Issued;
+  s_Current.StateChangesSkipped = counters.Skipped;
+  GLState::ResetCounters();
+
+  s_LastFrame = s_Current;
+  s_Current = RenderStats();
+  return s_LastFrame;
+}
+
+void RenderStats::OnImGuiRender(const RenderStats &stats) {
+  ImGui::Text("Draw calls: %u, triangles: %llu", stats.DrawCalls, stats.Triangles);
+  ImGui::Text("Binds: %u program, %u VAO, %u buffer, %u texture", stats.ProgramBinds,
+              stats.VertexArrayBinds, stats.BufferBinds, stats.TextureBinds);
+  ImGui::Text("GL state changes: %u issued, %u skipped", stats.StateChanges,
+              stats.StateChangesSkipped);
+  ImGui::Text("Uniform uploads: %u", stats.UniformUploads);
+  ImGui::Text("Uploaded: %.1f KB buffers, %.1f KB textures", stats.BufferBytes / 1024.0,
+              stats.TextureBytes / 1024.0);
+}
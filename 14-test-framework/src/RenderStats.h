@@ -0,0 +1,33 @@
+#pragma once
+
+// Per-frame counters of the work handed to the driver. The wrapper classes
+// bump RenderStats::Get() as they go (GL thread only); EndFrame closes the
+// frame and starts counting the next one.
+struct RenderStats {
+  unsigned int DrawCalls = 0;
+  unsigned long long Triangles = 0;
+  // Binds actually issued; GLState drops the redundant ones
+  unsigned int ProgramBinds = 0;
+  unsigned int VertexArrayBinds = 0;
+  unsigned int BufferBinds = 0;
+  unsigned int TextureBinds = 0;
+  // Every GLState call, binds included
+  unsigned int StateChanges = 0;
+  unsigned int StateChangesSkipped = 0;
+  unsigned int UniformUploads = 0;
+  unsigned long long BufferBytes = 0;  // Written to buffer objects
+  unsigned long long TextureBytes = 0; // Uploaded to textures
+
+  // Counters of the frame in progress
+  static inline RenderStats &Get() { return s_Current; }
+
+  // Close the frame, returning its counters
+  static const RenderStats &EndFrame();
+  static inline const RenderStats &GetLastFrame() { return s_LastFrame; }
+
+  // Table of the given counters for the ImGui test panel
+  static void OnImGuiRender(const RenderStats &stats);
+
+private:
+  static RenderStats s_Current, s_LastFrame;
+};
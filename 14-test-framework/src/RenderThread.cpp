@@ -0,0 +1,91 @@
+#include "RenderThread.h"
+
+#include <GLFW/glfw3.h>
+
+#include "Profiler.h"
+
+RenderThread::RenderThread(GLFWwindow *window)
+    : m_Window(window), m_Busy(false), m_Stopping(false) {
+  // A context can only be current on one thread at a time
+  glfwMakeContextCurrent(nullptr);
+  m_Thread = std::thread(&RenderThread::ThreadLoop, this);
+}
+
+RenderThread::~RenderThread() {
+  {
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_JobDone.wait(lock, [this] { return !m_Busy; });
+    m_Stopping = true;
+  }
+  m_JobAvailable.notify_one();
+  m_Thread.join();
+  glfwMakeContextCurrent(m_Window);
+}
+
+void RenderThread::Submit(std::function<void()> job) {
+  {
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_JobDone.wait(lock, [this] { return !m_Busy; });
+    m_Job = std::move(job);
+    m_Busy = true;
+  }
+  m_JobAvailable.notify_one();
+}
+
+void RenderThread::Wait() {
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  m_JobDone.wait(lock, [this] { return !m_Busy; });
+}
+
+void RenderThread::Run(std::function<void()> job) {
+  Submit(std::move(job));
+  Wait();
+}
+
+void RenderThread::ThreadLoop() {
+  Profiler::SetThreadName("Render");
+  glfwMakeContextCurrent(m_Window);
+  // The swap interval belongs to the current context on some platforms
+  glfwSwapInterval(1);
+
+  for (;;) {
+    std::function<void()> job;
+    {
+      std::unique_lock<std::mutex> lock(m_Mutex);
+      m_JobAvailable.wait(lock, [this] { return m_Stopping || m_Busy; });
+      if (!m_Busy) {
+        break; // Stopping and idle
+      }
+      job = std::move(m_Job);
+    }
+
+    job();
+
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      m_Busy = false;
+    }
+    m_JobDone.notify_all();
+  }
+
+  glfwMakeContextCurrent(nullptr);
+}
+
+ImGuiFrameSnapshot::~ImGuiFrameSnapshot() { Clear(); }
+
+void ImGuiFrameSnapshot::Capture(const ImDrawData *drawData) {
+  Clear();
+  m_Data = *drawData;
+  for (int i = 0; i < drawData->CmdListsCount; i++) {
+    m_Lists.push_back(drawData->CmdLists[i]->CloneOutput());
+  }
+  m_Data.CmdLists = m_Lists.data();
+}
+
+void ImGuiFrameSnapshot::Clear() {
+  for (ImDrawList *list : m_Lists) {
+    IM_DELETE(list);
+  }
+  m_Lists.clear();
+  m_Data = ImDrawData();
+}
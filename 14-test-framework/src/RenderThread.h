@@ -0,0 +1,61 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "imgui/imgui.h"
+
+struct GLFWwindow;
+
+// Thread that owns the window's OpenGL context and runs one job at a time.
+// While a frame job draws and waits on vsync, the thread that submitted it is
+// free to simulate the next frame.
+class RenderThread {
+public:
+  // Takes the context away from the calling thread, which must own it
+  RenderThread(GLFWwindow *window);
+  // Finishes the job in flight, then makes the context current on the calling
+  // thread again
+  ~RenderThread();
+
+  // Start a job without waiting for it. At most one job is in flight, so this
+  // blocks until the previous one has finished.
+  void Submit(std::function<void()> job);
+
+  // Block until the job in flight, if any, has finished
+  void Wait();
+
+  // Submit and Wait, for GL work the calling thread needs done now
+  void Run(std::function<void()> job);
+
+private:
+  void ThreadLoop();
+
+  GLFWwindow *m_Window;
+  std::function<void()> m_Job;
+  std::mutex m_Mutex;
+  std::condition_variable m_JobAvailable, m_JobDone;
+  bool m_Busy, m_Stopping;
+  std::thread m_Thread;
+};
+
+// Deep copy of one frame of ImGui output. ImGui's own draw data is only valid
+// until the next NewFrame, so the render thread draws from a copy while the
+// main thread builds the next frame.
+class ImGuiFrameSnapshot {
+public:
+  ~ImGuiFrameSnapshot();
+
+  void Capture(const ImDrawData *drawData);
+
+  inline ImDrawData *GetDrawData() { return &m_Data; }
+
+private:
+  void Clear();
+
+  ImDrawData m_Data;
+  std::vector<ImDrawList *> m_Lists;
+};
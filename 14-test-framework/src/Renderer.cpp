@@ -1,4 +1,6 @@
 #include "Renderer.h"
+#include "GPUProfiler.h"
+#include "RenderStats.h"
 
 #include <iomanip>
 #include <iostream>
@@ -25,8 +27,77 @@ void Renderer::Clear() const {
 }
 
 void Renderer::Draw(const VertexArray& va, const IndexBuffer& ib, const Shader& shader) const {
+    Draw(va, ib, shader, ib.GetCount());
+}
+
+void Renderer::Draw(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, unsigned int count, int baseVertex, unsigned int firstIndex) const {
+    PROFILE_SCOPE("Renderer::Draw");
+    shader.Bind();
+    va.Bind();
+    ib.Bind();
+    const void *indices = (const void *)(firstIndex * sizeof(unsigned int));
+    if (baseVertex) {
+      GLCall(glDrawElementsBaseVertex(GL_TRIANGLES, count, GL_UNSIGNED_INT, indices, baseVertex));
+    } else {
+      GLCall(glDrawElements(GL_TRIANGLES, count, GL_UNSIGNED_INT, indices));
+    }
+    RenderStats &stats = RenderStats::Get();
+    stats.DrawCalls++;
+    stats.Triangles += count / 3;
+}
+
+void Renderer::DrawInstanced(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, unsigned int instanceCount) const {
+    GPU_PROFILE_SCOPE("Renderer::DrawInstanced");
+    shader.Bind();
+    va.Bind();
+    ib.Bind();
+    GLCall(glDrawElementsInstanced(GL_TRIANGLES, ib.GetCount(), GL_UNSIGNED_INT, nullptr, instanceCount));
+    RenderStats &stats = RenderStats::Get();
+    stats.DrawCalls++;
+    stats.Triangles += (unsigned long long)(ib.GetCount() / 3) * instanceCount;
+}
+
+
+void Renderer::MultiDrawIndirect(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, const IndirectBuffer& indirect) const {
+    MultiDrawIndirect(va, ib, shader, indirect, 0, indirect.GetCount());
+}
+
+void Renderer::MultiDrawIndirect(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, const IndirectBuffer& indirect, unsigned int first, unsigned int count) const {
+    PROFILE_SCOPE("Renderer::MultiDrawIndirect");
+    ASSERT(first + count <= indirect.GetCount());
     shader.Bind();
     va.Bind();
     ib.Bind();
-    GLCall(glDrawElements(GL_TRIANGLES, ib.GetCount(), GL_UNSIGNED_INT, nullptr));
-}
\ No newline at end of file
+    RenderStats &stats = RenderStats::Get();
+    const DrawElementsIndirectCommand *commands = indirect.GetCommands().data() + first;
+    for (unsigned int i = 0; i < count; i++) {
+      stats.Triangles += (unsigned long long)(commands[i].Count / 3) * commands[i].InstanceCount;
+    }
+
+    if (IndirectBuffer::IsSupported()) {
+      indirect.Bind();
+      const void *offset = (const void *)(first * sizeof(DrawElementsIndirectCommand));
+      GLCall(glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, offset, count, 0));
+      stats.DrawCalls++;
+      return;
+    }
+
+    bool baseInstance = IndirectBuffer::IsBaseInstanceSupported();
+    for (unsigned int i = 0; i < count; i++) {
+      const DrawElementsIndirectCommand &command = commands[i];
+      const void *indices = (const void *)(command.FirstIndex * sizeof(unsigned int));
+      if (baseInstance) {
+        GLCall(glDrawElementsInstancedBaseVertexBaseInstance(GL_TRIANGLES, command.Count, GL_UNSIGNED_INT, indices,
+                                                            command.InstanceCount, command.BaseVertex, command.BaseInstance));
+      } else {
+        // Move the per-instance attributes instead; only they see BaseInstance
+        va.SetBaseInstance(command.BaseInstance);
+        GLCall(glDrawElementsInstancedBaseVertex(GL_TRIANGLES, command.Count, GL_UNSIGNED_INT, indices,
+                                                 command.InstanceCount, command.BaseVertex));
+      }
+    }
+    if (!baseInstance) {
+      va.SetBaseInstance(0);
+    }
+    stats.DrawCalls += count;
+}
@@ -13,9 +13,16 @@
 
 // Wrap GL calls in this to check for errors
 // This macro won't work for one line if statements, etc
+// The mode is picked by GL_ERROR_MODE in CMakeLists.txt. glGetError checking
+// is the default; with NONE or DEBUG_OUTPUT (errors arrive through the
+// GL_KHR_debug callback instead, see GLDebug.h) GLCall is just the call.
+#if defined(GL_ERROR_MODE_NONE) || defined(GL_ERROR_MODE_DEBUG_OUTPUT)
+#define GLCall(x) x
+#else
 #define GLCall(x) GLClearError();\
   x;\
   ASSERT(GLLogCall(#x, __FILE__, __LINE__)); // #x turns x into a string.
+#endif
 
 // Clear OpenGL errors
 void GLClearError(); 
@@ -23,9 +30,11 @@ void GLClearError();
 // Return false if there are any OpenGl errors.
 bool GLLogCall(const char* function, const char* file, int line);
 
+#include "GLState.h"
 #include "VertexArray.h"
 #include "IndexBuffer.h"
 #include "Shader.h"
+#include "IndirectBuffer.h"
 
 class Renderer {
   private:
@@ -33,4 +42,16 @@ class Renderer {
   public:
   void Clear() const;
   void Draw(const VertexArray& va, const IndexBuffer& ib, const Shader& shader) const;
+  // Draw count indices of ib starting at firstIndex, adding baseVertex to each index
+  void Draw(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, unsigned int count, int baseVertex = 0, unsigned int firstIndex = 0) const;
+  // Draw ib instanceCount times; per-instance attributes advance by their divisor
+  void DrawInstanced(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, unsigned int instanceCount) const;
+  // Draw count commands of indirect starting at first, each a range of ib with
+  // its own base vertex, in one glMultiDrawElementsIndirect. Per-draw data is
+  // found through BaseInstance (an instanced attribute starts there) or
+  // gl_DrawID with ARB_shader_draw_parameters. Without multi-draw indirect
+  // the commands are issued one call each, re-pointing the per-instance
+  // attributes of va where base instance is missing too.
+  void MultiDrawIndirect(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, const IndirectBuffer& indirect, unsigned int first, unsigned int count) const;
+  void MultiDrawIndirect(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, const IndirectBuffer& indirect) const;
 };
\ No newline at end of file
@@ -1,51 +1,102 @@
 #include "Shader.h"
 
+#include <algorithm>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <string>
 #include <sstream>
+#include <string_view>
 
+#include "AssetPack.h"
+#include "Profiler.h"
+#include "ProgramCache.h"
 #include "Renderer.h"
+#include "RenderStats.h"
 
-Shader::Shader(const std::string &filepath) : m_Filepath(filepath), m_RendererID(0){
-      ShaderProgramSource source = ParseShader(filepath);
-  m_RendererID = CreateShader(source.VertexSource, source.FragmentSource);
+Shader::Shader(const std::string &filepath, const ShaderOptions &options)
+    : m_Filepath(filepath), m_RendererID(0), m_PendingVertex(0),
+      m_PendingFragment(0), m_Options(options), m_Ready(false) {
+  Build(ParseShader(filepath));
+}
+
+Shader::Shader(const ShaderProgramSource &source, const ShaderOptions &options)
+    : m_RendererID(0), m_PendingVertex(0), m_PendingFragment(0),
+      m_Options(options), m_Ready(false) {
+  Build(source);
+}
+
+void Shader::Build(const ShaderProgramSource &source) {
+  PROFILE_SCOPE("Shader::Build");
+  // A cached binary skips the GLSL compiler entirely
+  if (m_Options.UseCache) {
+    m_RendererID = ProgramCache::Load(source.VertexSource, source.FragmentSource);
+  }
+  if (m_RendererID) {
+    m_Ready = true;
+  } else if (m_Options.Async) {
+    StartProgram(source);
+  } else {
+    m_RendererID = CreateShader(source.VertexSource, source.FragmentSource);
+    if (m_Options.UseCache) {
+      ProgramCache::Store(m_RendererID, source.VertexSource, source.FragmentSource);
+    }
+    m_Ready = true;
+  }
 }
 
 Shader::~Shader() {
+    if (m_PendingVertex || m_PendingFragment) {
+      GLCall(glDeleteShader(m_PendingVertex));
+      GLCall(glDeleteShader(m_PendingFragment));
+    }
+    GLState::OnDeleteProgram(m_RendererID);
     GLCall(glDeleteProgram(m_RendererID));
 }
 
-// Parse shader from file
+// Parse shader from a mounted asset pack, or the file system
 ShaderProgramSource Shader::ParseShader(const std::string& filepath) {
-  std::ifstream stream(filepath);
-
-  enum class ShaderType {
-    NONE = -1, VERTEX = 0, FRAGMENT = 1
-  };
-
-  std::string line;
-  std::stringstream ss[2];
-  ShaderType type = ShaderType::NONE;
-  while (getline(stream, line)) {
-    if (line.find("#shader") != std::string::npos) {
-      if (line.find("vertex") != std::string::npos) {
-        type = ShaderType::VERTEX;
-      } 
-      else if (line.find("fragment") != std::string::npos) {
-        type = ShaderType::FRAGMENT;
-      }
+  const AssetPack::Asset *asset = AssetPack::FindMounted(filepath);
+  if (asset && asset->AssetType == AssetPack::Type::Shader) {
+    return ParseShader((const char *)asset->Data, asset->Size);
+  }
+
+  std::ifstream stream(filepath, std::ios::binary);
+  std::string source((std::istreambuf_iterator<char>(stream)),
+                     std::istreambuf_iterator<char>());
+  return ParseShader(source.data(), source.size());
+}
+
+ShaderProgramSource Shader::ParseShader(const char *source, size_t length) {
+  ShaderProgramSource result;
+  std::string *target = nullptr; // Where lines go, set by each #shader line
+  const char *end = source + length;
+  for (const char *line = source; line < end;) {
+    const char *next = std::find(line, end, '\n');
+    size_t lineLength = next - line;
+    if (lineLength > 0 && line[lineLength - 1] == '\r') {
+      lineLength--; // Files checked out with Windows line endings
     }
-    else {
-      ss[(int)type] << line << "\n";
+    std::string_view text(line, lineLength);
+    if (text.find("#shader") != std::string_view::npos) {
+      target = nullptr;
+      if (text.find("vertex") != std::string_view::npos) {
+        target = &result.VertexSource;
+      } else if (text.find("fragment") != std::string_view::npos) {
+        target = &result.FragmentSource;
+      }
+    } else if (target) {
+      target->append(text.data(), text.size());
+      target->push_back('\n');
     }
+    line = next + 1;
   }
-  return { ss[0].str(), ss[1].str() };
+  return result;
 }
 
-// Compile shader and return its ID
-unsigned int Shader::CompileShader(unsigned int type, const std::string& source) {
+// Hand the source to the driver and return the shader ID without waiting
+unsigned int Shader::StartCompile(unsigned int type, const std::string& source) {
     GLCall(unsigned int id = glCreateShader(type));
     const char* src = source.c_str(); // equivalently &source[0]; source must not be out of scope!
     
@@ -54,7 +105,11 @@ unsigned int Shader::CompileShader(unsigned int type, const std::string& source)
 
     // Compile the source
     GLCall(glCompileShader(id));
+    return id;
+}
 
+// Wait for the compile to finish and log any errors
+bool Shader::CheckCompile(unsigned int id, unsigned int type) {
     int result;
     GLCall(glGetShaderiv(id, GL_COMPILE_STATUS, &result));
     
@@ -69,10 +124,19 @@ unsigned int Shader::CompileShader(unsigned int type, const std::string& source)
      std::cout << "Error: "
                << ((type == GL_VERTEX_SHADER) ? "Vertex" : "Fragment")
                << " shader compilation failed: " << message << std::endl;
+     return false;
+   }
+   return true;
+}
+
+// Compile shader and return its ID
+unsigned int Shader::CompileShader(unsigned int type, const std::string& source) {
+    unsigned int id = StartCompile(type, source);
+    if (!CheckCompile(id, type)) {
      GLCall(glDeleteShader(id));
      return 0;
-   }
-   return id;
+    }
+    return id;
 }
 
 // Combine vertex and fragment shaders into a shader program, returns program ID
@@ -87,6 +151,11 @@ unsigned int Shader::CreateShader(const std::string& vertexShader, const std::st
     GLCall(glAttachShader(program, vs));
     GLCall(glAttachShader(program, fs));
 
+    // Ask the driver to keep a binary we can hand to ProgramCache
+    if (ProgramCache::IsSupported()) {
+      GLCall(glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+    }
+
     // Perform linking
     GLCall(glLinkProgram(program));
 
@@ -102,40 +171,132 @@ unsigned int Shader::CreateShader(const std::string& vertexShader, const std::st
     return program;
 }
 
+// Async counterpart of CreateShader: compile and link without querying any
+// status, since every query waits for the driver to finish
+void Shader::StartProgram(const ShaderProgramSource &source) {
+    m_PendingSource = source;
+    m_PendingVertex = StartCompile(GL_VERTEX_SHADER, m_PendingSource.VertexSource);
+    m_PendingFragment = StartCompile(GL_FRAGMENT_SHADER, m_PendingSource.FragmentSource);
+
+    GLCall(m_RendererID = glCreateProgram());
+    GLCall(glAttachShader(m_RendererID, m_PendingVertex));
+    GLCall(glAttachShader(m_RendererID, m_PendingFragment));
+    if (m_Options.UseCache && ProgramCache::IsSupported()) {
+      GLCall(glProgramParameteri(m_RendererID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+    }
+    GLCall(glLinkProgram(m_RendererID));
+}
+
+void Shader::FinishProgram() {
+    PROFILE_SCOPE("Shader::FinishProgram");
+    CheckCompile(m_PendingVertex, GL_VERTEX_SHADER);
+    CheckCompile(m_PendingFragment, GL_FRAGMENT_SHADER);
+
+    int linked;
+    GLCall(glGetProgramiv(m_RendererID, GL_LINK_STATUS, &linked));
+    if (linked == GL_FALSE) {
+      std::cout << "Error: Shader program link failed: " << m_Filepath << std::endl;
+    } else if (m_Options.UseCache) {
+      ProgramCache::Store(m_RendererID, m_PendingSource.VertexSource,
+                          m_PendingSource.FragmentSource);
+    }
+
+    GLCall(glDeleteShader(m_PendingVertex));
+    GLCall(glDeleteShader(m_PendingFragment));
+    m_PendingVertex = m_PendingFragment = 0;
+    m_PendingSource = ShaderProgramSource();
+    m_Ready = true;
+}
+
+bool Shader::IsReady() {
+    if (m_Ready) {
+      return true;
+    }
+    // Without the extension there is no way to ask without blocking
+    if (GLEW_KHR_parallel_shader_compile || GLEW_ARB_parallel_shader_compile) {
+      int complete;
+      GLCall(glGetProgramiv(m_RendererID, GL_COMPLETION_STATUS_KHR, &complete));
+      if (complete == GL_FALSE) {
+        return false;
+      }
+    }
+    FinishProgram();
+    return true;
+}
+
 void Shader::Bind() const {
-    GLCall(glUseProgram(m_RendererID));
+    GLState::UseProgram(m_RendererID);
 }
 
 void Shader::Unbind() const {
-    GLCall(glUseProgram(0));
+    GLState::UseProgram(0);
 }
 
-void Shader::SetUniform1i(const std::string &name, int v0) {
+void Shader::SetUniform1i(const UniformName &name, int v0) {
   GLCall(glUniform1i(GetUniformLocation(name), v0));
+  RenderStats::Get().UniformUploads++;
 }
 
-void Shader::SetUniform1f(const std::string &name, float v0) {
+void Shader::SetUniform1iv(const UniformName &name, int count, const int *values) {
+  GLCall(glUniform1iv(GetUniformLocation(name), count, values));
+  RenderStats::Get().UniformUploads++;
+}
+
+void Shader::SetUniform1f(const UniformName &name, float v0) {
   GLCall(glUniform1f(GetUniformLocation(name), v0));
+  RenderStats::Get().UniformUploads++;
 }
 
-void Shader::SetUniform4f(const std::string &name, float v0, float v1, float v2, float v3) {
+void Shader::SetUniform4f(const UniformName &name, float v0, float v1, float v2, float v3) {
   GLCall(glUniform4f(GetUniformLocation(name), v0, v1, v2, v3));
+  RenderStats::Get().UniformUploads++;
 }
 
-void Shader::SetUniformMat4f(const std::string &name, const glm::mat4& matrix) {
+void Shader::SetUniformMat4f(const UniformName &name, const glm::mat4& matrix) {
   GLCall(glUniformMatrix4fv(GetUniformLocation(name), 1, GL_FALSE, &matrix[0][0]));
+  RenderStats::Get().UniformUploads++;
+}
+
+void Shader::SetUniformBlockBinding(const UniformName &block, unsigned int binding) {
+  GLCall(unsigned int index = glGetUniformBlockIndex(m_RendererID, block.Name));
+  if (index == GL_INVALID_INDEX) {
+    std::cout << "Warning: uniform block " << block.Name << " doesn't exist!" << std::endl;
+    return;
+  }
+  GLCall(glUniformBlockBinding(m_RendererID, index, binding));
+}
+
+void Shader::SetUniform(Uniform<int> uniform, int v0) {
+  GLCall(glUniform1i(uniform.Location, v0));
+  RenderStats::Get().UniformUploads++;
+}
+
+void Shader::SetUniform(Uniform<float> uniform, float v0) {
+  GLCall(glUniform1f(uniform.Location, v0));
+  RenderStats::Get().UniformUploads++;
+}
+
+void Shader::SetUniform(Uniform<glm::vec4> uniform, const glm::vec4 &value) {
+  GLCall(glUniform4f(uniform.Location, value.x, value.y, value.z, value.w));
+  RenderStats::Get().UniformUploads++;
+}
+
+void Shader::SetUniform(Uniform<glm::mat4> uniform, const glm::mat4 &matrix) {
+  GLCall(glUniformMatrix4fv(uniform.Location, 1, GL_FALSE, &matrix[0][0]));
+  RenderStats::Get().UniformUploads++;
 }
 
-int Shader::GetUniformLocation(const std::string &name) {
-    if(m_UniformLocationCache.find(name) != m_UniformLocationCache.end()) {
-      return m_UniformLocationCache[name];
+int Shader::GetUniformLocation(const UniformName &name) {
+    auto it = m_UniformLocationCache.find(name.Hash);
+    if(it != m_UniformLocationCache.end()) {
+      return it->second;
     }
 
-    GLCall(int location = glGetUniformLocation(m_RendererID, name.c_str()));
+    GLCall(int location = glGetUniformLocation(m_RendererID, name.Name));
     if(location==-1) {
-        std::cout<<"Warning: uniform " << name << " doesn't exist!" << std::endl;
+        std::cout<<"Warning: uniform " << name.Name << " doesn't exist!" << std::endl;
     }
 
-    m_UniformLocationCache[name] = location;
+    m_UniformLocationCache.emplace(name.Hash, location);
     return location;
 }
@@ -1,38 +1,106 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 #include <glm/glm.hpp>
 
+#include "Hash.h"
+
 struct ShaderProgramSource {
   std::string VertexSource;
   std::string FragmentSource;
 };
 
+struct ShaderOptions {
+  // Issue the compile and link and return without waiting for the driver.
+  // The shader must not be bound until IsReady() returns true.
+  bool Async = false;
+  // Load and store program binaries through ProgramCache
+  bool UseCache = true;
+};
+
+// A uniform name with its hash. Passing a string literal hashes it on the
+// spot without allocating; declare it static constexpr to hash at compile time:
+//   static constexpr UniformName u_MVP("u_MVP");
+struct UniformName {
+  const char *Name;
+  uint64_t Hash;
+
+  constexpr UniformName(const char *name)
+      : Name(name), Hash(Fnv1a64(name, std::char_traits<char>::length(name))) {}
+  UniformName(const std::string &name) : Name(name.c_str()), Hash(Fnv1a64(name)) {}
+};
+
+// A uniform location resolved once through Shader::GetUniform. Setting a value
+// through it skips the name lookup entirely. T is the GLSL type's C++
+// counterpart, so a handle can only be set with matching data.
+template <typename T> struct Uniform {
+  int Location = -1;
+};
+
 class Shader {
 private:
   std::string m_Filepath;
   unsigned int m_RendererID;
-  std::unordered_map<std::string, int> m_UniformLocationCache;
+  std::unordered_map<uint64_t, int> m_UniformLocationCache; // Keyed by name hash
+
+  // Async builds: shader objects and sources kept until the link is checked
+  unsigned int m_PendingVertex, m_PendingFragment;
+  ShaderProgramSource m_PendingSource;
+  ShaderOptions m_Options;
+  bool m_Ready;
 
 public:
-  Shader(const std::string &filepath);
+  Shader(const std::string &filepath, const ShaderOptions &options = ShaderOptions());
+  Shader(const ShaderProgramSource &source, const ShaderOptions &options = ShaderOptions());
   ~Shader();
 
+  // Always true for blocking builds. For async builds this only blocks if
+  // GL_KHR_parallel_shader_compile is unavailable; see ShaderCompiler.
+  bool IsReady();
+
+  // Split a .shader file into its vertex and fragment sources. A shader with
+  // that path in a mounted AssetPack is read from the pack instead.
+  static ShaderProgramSource ParseShader(const std::string &filepath);
+  static ShaderProgramSource ParseShader(const char *source, size_t length);
+
+  inline unsigned int GetRendererID() const { return m_RendererID; }
+
   void Bind() const;
   void Unbind() const;
 
   // Set uniforms
-  void SetUniform1i(const std::string &name, int v0);
-  void SetUniform1f(const std::string &name, float v0);
-  void SetUniform4f(const std::string &name, float v0, float v1, float v2,
+  void SetUniform1i(const UniformName &name, int v0);
+  void SetUniform1iv(const UniformName &name, int count, const int *values);
+  void SetUniform1f(const UniformName &name, float v0);
+  void SetUniform4f(const UniformName &name, float v0, float v1, float v2,
                     float v3);
-  void SetUniformMat4f(const std::string &name, const glm::mat4& matrix);
+  void SetUniformMat4f(const UniformName &name, const glm::mat4& matrix);
+
+  // Point a std140 uniform block at an indexed GL_UNIFORM_BUFFER binding
+  void SetUniformBlockBinding(const UniformName &block, unsigned int binding);
+
+  // Resolve a uniform once, then set it per draw with SetUniform
+  template <typename T> Uniform<T> GetUniform(const UniformName &name) {
+    Uniform<T> uniform;
+    uniform.Location = GetUniformLocation(name);
+    return uniform;
+  }
+
+  void SetUniform(Uniform<int> uniform, int v0);
+  void SetUniform(Uniform<float> uniform, float v0);
+  void SetUniform(Uniform<glm::vec4> uniform, const glm::vec4 &value);
+  void SetUniform(Uniform<glm::mat4> uniform, const glm::mat4 &matrix);
 
 private:
-  ShaderProgramSource ParseShader(const std::string &filepath);
+  void Build(const ShaderProgramSource &source);
+  unsigned int StartCompile(unsigned int type, const std::string &source);
+  bool CheckCompile(unsigned int id, unsigned int type);
   unsigned int CompileShader(unsigned int type, const std::string &source);
   unsigned int CreateShader(const std::string &vertexShader,
                             const std::string &fragmentShader);
-  int GetUniformLocation(const std::string &name);
+  void StartProgram(const ShaderProgramSource &source);
+  void FinishProgram();
+  int GetUniformLocation(const UniformName &name);
 };
\ No newline at end of file
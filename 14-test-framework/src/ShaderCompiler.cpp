@@ -0,0 +1,32 @@
+#include "ShaderCompiler.h"
+
+#include <algorithm>
+
+#include "Renderer.h"
+
+ShaderCompiler::ShaderCompiler() {
+  // Let the driver pick how many compiler threads to use
+  if (GLEW_KHR_parallel_shader_compile) {
+    GLCall(glMaxShaderCompilerThreadsKHR(0xFFFFFFFF));
+  } else if (GLEW_ARB_parallel_shader_compile) {
+    GLCall(glMaxShaderCompilerThreadsARB(0xFFFFFFFF));
+  }
+}
+
+bool ShaderCompiler::IsParallelSupported() {
+  return GLEW_KHR_parallel_shader_compile || GLEW_ARB_parallel_shader_compile;
+}
+
+void ShaderCompiler::Add(Shader &shader) { m_Pending.push_back(&shader); }
+
+unsigned int ShaderCompiler::Poll() {
+  m_Pending.erase(std::remove_if(m_Pending.begin(), m_Pending.end(),
+                                 [](Shader *shader) { return shader->IsReady(); }),
+                  m_Pending.end());
+  return m_Pending.size();
+}
+
+void ShaderCompiler::WaitAll() {
+  while (Poll() > 0) {
+  }
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <vector>
+
+#include "Shader.h"
+
+// Waits on many async Shaders at once so their compiles overlap. Create the
+// shaders with ShaderOptions::Async, Add() them, then call Poll() once per
+// frame until it returns 0. With GL_KHR_parallel_shader_compile Poll() never
+// blocks; without it each pending shader is finished on the first poll.
+class ShaderCompiler {
+public:
+  ShaderCompiler();
+
+  void Add(Shader &shader);
+
+  // Finish every shader whose link has completed; returns how many are left
+  unsigned int Poll();
+  void WaitAll();
+
+  static bool IsParallelSupported();
+
+private:
+  std::vector<Shader *> m_Pending;
+};
@@ -0,0 +1,87 @@
+#include "StreamingVertexBuffer.h"
+
+#include "Renderer.h"
+#include "RenderStats.h"
+
+StreamingVertexBuffer::StreamingVertexBuffer(unsigned int stride,
+                                             unsigned int maxVertices,
+                                             unsigned int frameCount)
+    : m_Stride(stride), m_MaxVertices(maxVertices), m_FrameCount(frameCount),
+      m_Frame(0), m_Head(0), m_Mapped(nullptr) {
+  GLState::BindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+  if (GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage) {
+    unsigned int size = m_Stride * m_MaxVertices * m_FrameCount;
+    GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    GLCall(glBufferStorage(GL_ARRAY_BUFFER, size, nullptr, flags));
+    GLCall(m_Mapped = (char *)glMapBufferRange(GL_ARRAY_BUFFER, 0, size, flags));
+    m_Fences.resize(m_FrameCount, nullptr);
+    m_Frame = m_FrameCount - 1;
+  } else {
+    // Orphaning replaces the regions, so one frame's worth is enough
+    m_FrameCount = 1;
+    GLCall(glBufferData(GL_ARRAY_BUFFER, m_Stride * m_MaxVertices, nullptr, GL_STREAM_DRAW));
+    m_Staging.resize(m_Stride * m_MaxVertices);
+  }
+}
+
+StreamingVertexBuffer::~StreamingVertexBuffer() {
+  for (GLsync fence : m_Fences) {
+    if (fence) {
+      GLCall(glDeleteSync(fence));
+    }
+  }
+  if (m_Mapped) {
+    GLState::BindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+    GLCall(glUnmapBuffer(GL_ARRAY_BUFFER));
+  }
+}
+
+void StreamingVertexBuffer::BeginFrame() {
+  m_Head = 0;
+
+  if (!m_Mapped) {
+    GLState::BindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+    GLCall(glBufferData(GL_ARRAY_BUFFER, m_Stride * m_MaxVertices, nullptr, GL_STREAM_DRAW));
+    return;
+  }
+
+  m_Frame = (m_Frame + 1) % m_FrameCount;
+  GLsync &fence = m_Fences[m_Frame];
+  if (fence) {
+    // Normally signalled long ago; only a GPU several frames behind waits here
+    GLenum result;
+    do {
+      GLCall(result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000));
+    } while (result == GL_TIMEOUT_EXPIRED);
+    GLCall(glDeleteSync(fence));
+    fence = nullptr;
+  }
+}
+
+void StreamingVertexBuffer::EndFrame() {
+  if (m_Mapped) {
+    GLCall(m_Fences[m_Frame] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+  }
+}
+
+void *StreamingVertexBuffer::Map(unsigned int count) {
+  if (m_Head + count > m_MaxVertices) {
+    return nullptr;
+  }
+  if (m_Mapped) {
+    return m_Mapped + (m_Frame * m_MaxVertices + m_Head) * m_Stride;
+  }
+  return m_Staging.data() + m_Head * m_Stride;
+}
+
+int StreamingVertexBuffer::Unmap(unsigned int count) {
+  int baseVertex = m_Frame * m_MaxVertices + m_Head;
+  if (!m_Mapped) {
+    GLState::BindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+    GLCall(glBufferSubData(GL_ARRAY_BUFFER, m_Head * m_Stride, count * m_Stride,
+                           m_Staging.data() + m_Head * m_Stride));
+  }
+  m_Head += count;
+  RenderStats::Get().BufferBytes += count * m_Stride;
+  return baseVertex;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <vector>
+
+#include <GL/glew.h>
+
+#include "VertexBuffer.h"
+
+// Vertex buffer for geometry rewritten every frame (sprites, particles, UI).
+// Vertices are written in place and drawn with a base vertex, so attribute
+// pointers set up by VertexArray::AddBuffer stay valid.
+//
+// With GL 4.4 / ARB_buffer_storage the buffer is persistently and coherently
+// mapped and split into frameCount regions. Each frame writes into its own
+// region, and a fence set at EndFrame() is waited on before that region is
+// reused, so writes never touch memory the GPU may still be reading. On older
+// contexts the buffer is orphaned at BeginFrame() and filled with
+// glBufferSubData, which lets the driver hand out fresh storage instead of
+// stalling.
+class StreamingVertexBuffer : public VertexBuffer {
+public:
+  // stride is the vertex size; maxVertices is the capacity of one frame
+  StreamingVertexBuffer(unsigned int stride, unsigned int maxVertices,
+                        unsigned int frameCount = 3);
+  ~StreamingVertexBuffer();
+
+  void BeginFrame();
+  void EndFrame();
+
+  // Space for up to count vertices, or nullptr if the frame's region is full.
+  // Every Map must be followed by Unmap before the next Map.
+  void *Map(unsigned int count);
+  // Commit the first count mapped vertices; returns their base vertex
+  int Unmap(unsigned int count);
+
+  inline bool IsPersistent() const { return m_Mapped != nullptr; }
+  // Vertices still free in this frame's region
+  inline unsigned int GetFreeVertices() const { return m_MaxVertices - m_Head; }
+
+private:
+  unsigned int m_Stride, m_MaxVertices, m_FrameCount;
+  unsigned int m_Frame;
+  unsigned int m_Head; // Vertices used in the current region
+  char *m_Mapped;
+  std::vector<char> m_Staging;
+  std::vector<GLsync> m_Fences;
+};
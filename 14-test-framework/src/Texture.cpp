@@ -1,43 +1,290 @@
 #include "Texture.h"
+#include "AssetPack.h"
+#include "CompressedImage.h"
+#include "Profiler.h"
+#include "RenderStats.h"
 
 #include "stb_image/stb_image.h"
 
-Texture::Texture(const std::string &path)
+#include <algorithm>
+#include <iostream>
+
+Texture::Texture(const std::string &path, const TextureOptions &options)
     : m_RendererID(0), m_FilePath(path), m_LocalBuffer(nullptr), m_Width(0),
-      m_Height(0), m_BPP(0) {
+      m_Height(0), m_BPP(0), m_Resident(true), m_Options(options), m_Levels(1) {
+  PROFILE_SCOPE("Texture::Load");
+  // A mounted pack holds it ready to upload straight from the mapping
+  const AssetPack::Asset *asset = AssetPack::FindMounted(path);
+  if (asset && asset->AssetType == AssetPack::Type::Texture) {
+    CreateFromAsset(*asset);
+    return;
+  }
+
+  // Pre-compressed files skip decoding entirely and stay compressed in VRAM
+  if (CompressedImage::IsCompressedFile(path)) {
+    CompressedImage image;
+    if (image.Load(path) && IsFormatSupported(image.Format)) {
+      CreateCompressed(image.Format, image.GetWidth(), image.GetHeight(),
+                       GetLevelPointers(image));
+      return;
+    }
+    // Leave an empty texture, the same as a PNG that fails to load
+    Create(nullptr);
+    return;
+  }
+
   // OpenGL expects texture pixels to start at the bottom left, so we flip the
   // PNG upside down
   stbi_set_flip_vertically_on_load(1);
   m_LocalBuffer = stbi_load(path.c_str(), &m_Width, &m_Height, &m_BPP, 4); // RGBA so 4 channels
 
+  Create(m_LocalBuffer);
+
+  if (m_LocalBuffer) {
+    stbi_image_free(m_LocalBuffer);
+  }
+}
+
+Texture::Texture(int width, int height, const unsigned char *pixels,
+                 const TextureOptions &options)
+    : m_RendererID(0), m_LocalBuffer(nullptr), m_Width(width),
+      m_Height(height), m_BPP(4), m_Resident(true), m_Options(options),
+      m_Levels(1) {
+  Create(pixels);
+}
+
+Texture::Texture(const CompressedImage &image, const TextureOptions &options)
+    : m_RendererID(0), m_LocalBuffer(nullptr), m_Width(0), m_Height(0),
+      m_BPP(0), m_Resident(true), m_Options(options), m_Levels(1) {
+  if (IsFormatSupported(image.Format)) {
+    CreateCompressed(image.Format, image.GetWidth(), image.GetHeight(),
+                     GetLevelPointers(image));
+  } else {
+    Create(nullptr);
+  }
+}
+
+Texture::Texture(const AssetPack::Asset &asset, const TextureOptions &options)
+    : m_RendererID(0), m_LocalBuffer(nullptr), m_Width(0), m_Height(0),
+      m_BPP(0), m_Resident(true), m_Options(options), m_Levels(1) {
+  CreateFromAsset(asset);
+}
+
+void Texture::CreateFromAsset(const AssetPack::Asset &asset) {
+  if (!asset.IsCompressed()) {
+    m_Width = asset.Width;
+    m_Height = asset.Height;
+    m_BPP = 4;
+    bool valid = asset.Size >= (size_t)m_Width * m_Height * 4;
+    Create(valid ? asset.Data : nullptr);
+    return;
+  }
+
+  // Point each level at its blocks inside the mapping, no copies
+  std::vector<const unsigned char *> levels;
+  size_t offset = 0;
+  for (int i = 0; i < asset.Levels; i++) {
+    int width = std::max(1, asset.Width >> i), height = std::max(1, asset.Height >> i);
+    size_t size = CompressedImage::GetLevelSize(asset.Format, width, height);
+    if (offset + size > asset.Size)
+      break;
+    levels.push_back(asset.Data + offset);
+    offset += size;
+  }
+  if (!levels.empty() && IsFormatSupported(asset.Format)) {
+    CreateCompressed(asset.Format, asset.Width, asset.Height, levels);
+  } else {
+    Create(nullptr);
+  }
+}
+
+std::vector<const unsigned char *> Texture::GetLevelPointers(const CompressedImage &image) {
+  std::vector<const unsigned char *> levels;
+  for (const CompressedImage::Level &level : image.Levels)
+    levels.push_back(level.Data.data());
+  return levels;
+}
+
+void Texture::Generate() {
   GLCall(glGenTextures(1, &m_RendererID));
-  GLCall(glBindTexture(GL_TEXTURE_2D, m_RendererID));
+  GLState::BindTexture(0, GL_TEXTURE_2D, m_RendererID);
 
   // These four texture parameters are REQUIRED, no default values are provided
   // Minification is used if area to texture is smaller than the texture,
   // magnification if larger
-  GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR)); // Minification filter
+  // The minification filter depends on the mip levels, see ApplySampling
   GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR)); // Magnification filter
 
   // Wrap mode, clamp means not to extend the area (vs tiling)
-  GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE)); // S = X = Horizontal
-  GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE)); // T = Y = Vertical
+  unsigned int wrap = m_Options.Repeat ? GL_REPEAT : GL_CLAMP_TO_EDGE;
+  GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrap)); // S = X = Horizontal
+  GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrap)); // T = Y = Vertical
+}
+
+void Texture::Create(const unsigned char *pixels) {
+  Generate();
 
   GLCall(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_Width, m_Height, 0,
-                          GL_RGBA, GL_UNSIGNED_BYTE, m_LocalBuffer));
+                          GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+  if (pixels) {
+    RenderStats::Get().TextureBytes += (unsigned long long)m_Width * m_Height * 4;
+  }
 
-  GLCall(glBindTexture(GL_TEXTURE_2D, 0)); // Unbind
+  // A texture without pixels (failed load) keeps the single level, otherwise
+  // sampling an incomplete chain would return black
+  m_Levels = 1;
+  if (m_Options.Mipmaps && pixels) {
+    PROFILE_SCOPE("Texture::Mipmaps");
+    if (m_Options.CpuMipmaps) {
+      std::vector<Mipmap::Level> chain =
+          Mipmap::BuildChain(pixels, m_Width, m_Height, m_Options.MipFilter);
+      for (const Mipmap::Level &level : chain) {
+        GLCall(glTexImage2D(GL_TEXTURE_2D, m_Levels++, GL_RGBA8, level.Width,
+                            level.Height, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                            level.Pixels.data()));
+        RenderStats::Get().TextureBytes += level.Pixels.size();
+      }
+    } else {
+      GLCall(glGenerateMipmap(GL_TEXTURE_2D));
+      m_Levels = Mipmap::GetLevelCount(m_Width, m_Height);
+    }
+  }
+  GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, m_Levels - 1));
+  ApplySampling();
 
-  if (m_LocalBuffer) {
-    stbi_image_free(m_LocalBuffer);
+  GLState::BindTexture(0, GL_TEXTURE_2D, 0); // Unbind
+}
+
+void Texture::CreateCompressed(CompressedImage::BlockFormat format, int width, int height,
+                               const std::vector<const unsigned char *> &levels) {
+  m_Width = width;
+  m_Height = height;
+  if (levels.empty()) {
+    std::cout << "Error: " << m_FilePath << " has no image levels" << std::endl;
+    Create(nullptr);
+    return;
   }
+  m_BPP = 0; // Not meaningful for block formats
+  Generate();
+
+  unsigned int internalFormat = GetInternalFormat(format);
+  for (size_t i = 0; i < levels.size(); i++) {
+    int levelWidth = std::max(1, width >> i), levelHeight = std::max(1, height >> i);
+    size_t size = CompressedImage::GetLevelSize(format, levelWidth, levelHeight);
+    GLCall(glCompressedTexImage2D(GL_TEXTURE_2D, (int)i, internalFormat, levelWidth,
+                                  levelHeight, 0, (int)size, levels[i]));
+    RenderStats::Get().TextureBytes += size;
+  }
+  m_Levels = (int)levels.size();
+  // glGenerateMipmap can't be relied on for compressed formats, bake the chain
+  if (m_Options.Mipmaps && m_Levels == 1 &&
+      Mipmap::GetLevelCount(m_Width, m_Height) > 1) {
+    std::cout << "Warning: " << m_FilePath
+              << " has no mipmaps, bake them with texture-baker" << std::endl;
+  }
+  GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, m_Levels - 1));
+  ApplySampling();
+
+  GLState::BindTexture(0, GL_TEXTURE_2D, 0); // Unbind
 }
 
-Texture::~Texture() { GLCall(glDeleteTextures(1, &m_RendererID)); }
+unsigned int Texture::GetInternalFormat(CompressedImage::BlockFormat format) {
+  switch (format) {
+  case CompressedImage::BlockFormat::BC1:
+    return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT; // RGBA so 1 bit alpha blocks work
+  case CompressedImage::BlockFormat::BC1_RGB:
+    return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+  case CompressedImage::BlockFormat::BC3:
+    return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+  case CompressedImage::BlockFormat::BC7:
+    return GL_COMPRESSED_RGBA_BPTC_UNORM;
+  case CompressedImage::BlockFormat::ETC2_RGB:
+    return GL_COMPRESSED_RGB8_ETC2;
+  case CompressedImage::BlockFormat::ETC2_RGBA:
+    return GL_COMPRESSED_RGBA8_ETC2_EAC;
+  default:
+    return 0;
+  }
+}
+
+bool Texture::IsFormatSupported(CompressedImage::BlockFormat format) {
+  bool supported = false;
+  switch (format) {
+  case CompressedImage::BlockFormat::BC1:
+  case CompressedImage::BlockFormat::BC1_RGB:
+  case CompressedImage::BlockFormat::BC3:
+    supported = GLEW_EXT_texture_compression_s3tc;
+    break;
+  case CompressedImage::BlockFormat::BC7:
+    supported = GLEW_VERSION_4_2 || GLEW_ARB_texture_compression_bptc;
+    break;
+  case CompressedImage::BlockFormat::ETC2_RGB:
+  case CompressedImage::BlockFormat::ETC2_RGBA:
+    supported = GLEW_VERSION_4_3 || GLEW_ARB_ES3_compatibility;
+    break;
+  default:
+    break;
+  }
+  if (!supported) {
+    std::cout << "Error: " << CompressedImage::GetFormatName(format)
+              << " textures are not supported by this driver" << std::endl;
+  }
+  return supported;
+}
+
+void Texture::ApplySampling() {
+  unsigned int minFilter = GL_LINEAR;
+  if (m_Levels > 1) {
+    minFilter = m_Options.Trilinear ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR_MIPMAP_NEAREST;
+  }
+  GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter));
+
+  float maxAnisotropy = GetMaxAnisotropy();
+  if (maxAnisotropy > 1.0f) {
+    float anisotropy = std::min(std::max(m_Options.Anisotropy, 1.0f), maxAnisotropy);
+    GLCall(glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, anisotropy));
+  }
+}
+
+void Texture::SetSampling(bool trilinear, float anisotropy) {
+  m_Options.Trilinear = trilinear;
+  m_Options.Anisotropy = anisotropy;
+  GLState::BindTexture(0, GL_TEXTURE_2D, m_RendererID);
+  ApplySampling();
+}
+
+float Texture::GetMaxAnisotropy() {
+  // Core since 4.6, an extension everywhere that matters before that
+  static float s_MaxAnisotropy = 0.0f;
+  if (s_MaxAnisotropy == 0.0f) {
+    s_MaxAnisotropy = 1.0f;
+    if (GLEW_ARB_texture_filter_anisotropic || GLEW_EXT_texture_filter_anisotropic) {
+      GLCall(glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, &s_MaxAnisotropy));
+    }
+  }
+  return s_MaxAnisotropy;
+}
+
+void Texture::Adopt(unsigned int rendererID, int width, int height) {
+  GLState::OnDeleteTexture(m_RendererID);
+  GLCall(glDeleteTextures(1, &m_RendererID));
+  m_RendererID = rendererID;
+  m_Width = width;
+  m_Height = height;
+  m_Resident = true;
+  // The loader uploads a single level with its own sampling
+  m_Levels = 1;
+}
+
+Texture::~Texture() {
+  GLState::OnDeleteTexture(m_RendererID);
+  GLCall(glDeleteTextures(1, &m_RendererID));
+}
 
 void Texture::Bind(unsigned int slot) const {
-  GLCall(glActiveTexture(GL_TEXTURE0 + slot)); // Bind texture slot
-  GLCall(glBindTexture(GL_TEXTURE_2D, m_RendererID));
+  GLState::BindTexture(slot, GL_TEXTURE_2D, m_RendererID);
 }
 
-void Texture::Unbind() const { GLCall(glBindTexture(GL_TEXTURE_2D, 0)); }
+void Texture::Unbind(unsigned int slot) const {
+  GLState::BindTexture(slot, GL_TEXTURE_2D, 0);
+}
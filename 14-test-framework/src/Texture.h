@@ -1,6 +1,25 @@
 #pragma once
 
 #include "Renderer.h"
+#include "AssetPack.h"
+#include "CompressedImage.h"
+#include "Mipmap.h"
+
+#include <glm/glm.hpp>
+
+struct TextureOptions {
+    // Build a mip chain down to 1x1 so minified sampling reads a prefiltered level
+    bool Mipmaps = false;
+    // Build the chain on the CPU with MipFilter instead of glGenerateMipmap
+    bool CpuMipmaps = false;
+    Mipmap::Filter MipFilter = Mipmap::Filter::Box;
+    // Blend between the two nearest levels rather than picking one
+    bool Trilinear = true;
+    // 1 is off. Clamped to the driver maximum, ignored without the extension.
+    float Anisotropy = 1.0f;
+    // Tile instead of clamping at the edges
+    bool Repeat = false;
+};
 
 class Texture {
     private:
@@ -8,14 +27,62 @@ class Texture {
     std::string m_FilePath;
     unsigned char* m_LocalBuffer;
     int m_Width, m_Height, m_BPP; // BPP == Bytes per pixel
+    bool m_Resident; // False while a TextureLoader placeholder
+    TextureOptions m_Options;
+    int m_Levels;
+
+    // Generates and binds the texture, and sets the wrap and magnification filter
+    void Generate();
+    void Create(const unsigned char* pixels);
+    // Uploads each level as is; level i is width >> i by height >> i
+    void CreateCompressed(CompressedImage::BlockFormat format, int width, int height,
+                          const std::vector<const unsigned char*>& levels);
+    void CreateFromAsset(const AssetPack::Asset& asset);
+    static std::vector<const unsigned char*> GetLevelPointers(const CompressedImage& image);
+    // Min filter and anisotropy for the bound texture, from m_Options
+    void ApplySampling();
+    // Take ownership of a finished texture, replacing the current one
+    void Adopt(unsigned int rendererID, int width, int height);
+
+    friend class TextureLoader;
 
     public:
-    Texture(const std::string& path);
+    // Looks in mounted asset packs first. Otherwise .dds and .ktx2 files are
+    // uploaded block compressed, anything else is decoded with stb_image.
+    Texture(const std::string& path, const TextureOptions& options = {});
+    // Texture from tightly packed RGBA8 pixels, bottom row first
+    Texture(int width, int height, const unsigned char* pixels,
+            const TextureOptions& options = {});
+    // Uploads the image's levels without recompressing
+    Texture(const CompressedImage& image, const TextureOptions& options = {});
+    // Uploads straight from the pack's mapping. Texture(path) does this
+    // already for paths in a mounted pack.
+    Texture(const AssetPack::Asset& asset, const TextureOptions& options = {});
     ~Texture();
 
     void Bind(unsigned int slot = 0) const;
-    void Unbind() const;
+    void Unbind(unsigned int slot = 0) const;
+
+    // Change the sampling without re-uploading. Trilinear only matters when
+    // the texture has mipmaps.
+    void SetSampling(bool trilinear, float anisotropy);
+    // Largest anisotropy the driver supports, 1 without the extension
+    static float GetMaxAnisotropy();
+    // Logs an error when the driver can't sample the format
+    static bool IsFormatSupported(CompressedImage::BlockFormat format);
+    static unsigned int GetInternalFormat(CompressedImage::BlockFormat format);
 
     inline int GetWidth() const { return m_Width; }
     inline int GetHeight() const { return m_Height; }
-};
\ No newline at end of file
+    inline unsigned int GetRendererID() const { return m_RendererID; }
+    inline bool IsResident() const { return m_Resident; }
+    inline int GetLevelCount() const { return m_Levels; }
+    inline const TextureOptions& GetOptions() const { return m_Options; }
+};
+
+// Part of a texture, such as one sprite on an atlas page. UVs are the bottom
+// left and top right corners.
+struct TextureRegion {
+    const Texture* Source = nullptr;
+    glm::vec2 UVMin = glm::vec2(0.0f), UVMax = glm::vec2(1.0f);
+};
@@ -0,0 +1,112 @@
+#include "TextureArray.h"
+
+#include <iostream>
+
+#include "RenderStats.h"
+
+#include "stb_image/stb_image.h"
+
+TextureArray::TextureArray(int width, int height, int layers)
+    : m_RendererID(0), m_Width(width), m_Height(height), m_Layers(layers) {
+  Create();
+}
+
+TextureArray::TextureArray(const std::vector<std::string> &paths)
+    : m_RendererID(0), m_Width(0), m_Height(0), m_Layers(paths.size()) {
+  if (paths.empty()) {
+    std::cout << "Error: texture array needs at least one image" << std::endl;
+    return;
+  }
+  int channels;
+  if (!stbi_info(paths[0].c_str(), &m_Width, &m_Height, &channels)) {
+    std::cout << "Error: texture array needs a readable first image" << std::endl;
+    m_Width = m_Height = 1;
+  }
+  Create();
+
+  for (int layer = 0; layer < m_Layers; layer++) {
+    LoadLayer(layer, paths[layer]);
+  }
+}
+
+void TextureArray::Create() {
+  // Zero-sized storage is GL_INVALID_VALUE; leave the array unallocated instead
+  if (m_Layers < 1 || m_Width < 1 || m_Height < 1) {
+    std::cout << "Error: texture array of " << m_Width << "x" << m_Height << "x"
+              << m_Layers << " is empty" << std::endl;
+    m_Layers = 0;
+    return;
+  }
+
+  int maxLayers;
+  GLCall(glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayers));
+  if (m_Layers > maxLayers) {
+    std::cout << "Warning: " << m_Layers << " texture array layers requested, GL allows "
+              << maxLayers << std::endl;
+    m_Layers = maxLayers;
+  }
+
+  GLCall(glGenTextures(1, &m_RendererID));
+  GLState::BindTexture(0, GL_TEXTURE_2D_ARRAY, m_RendererID);
+
+  // Same sampling as Texture
+  GLCall(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
+  GLCall(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+  GLCall(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+  GLCall(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+
+  // Immutable storage where available; GL 3.3 allocates the same thing mutably
+  if (GLEW_VERSION_4_2 || GLEW_ARB_texture_storage) {
+    GLCall(glTexStorage3D(GL_TEXTURE_2D_ARRAY, 1, GL_RGBA8, m_Width, m_Height, m_Layers));
+  } else {
+    GLCall(glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, m_Width, m_Height, m_Layers, 0,
+                        GL_RGBA, GL_UNSIGNED_BYTE, nullptr));
+  }
+
+  GLState::BindTexture(0, GL_TEXTURE_2D_ARRAY, 0); // Unbind
+}
+
+TextureArray::~TextureArray() {
+  GLState::OnDeleteTexture(m_RendererID);
+  GLCall(glDeleteTextures(1, &m_RendererID));
+}
+
+void TextureArray::SetLayer(int layer, const unsigned char *pixels) {
+  if (layer < 0 || layer >= m_Layers) {
+    std::cout << "Warning: texture array layer " << layer << " out of range" << std::endl;
+    return;
+  }
+  GLState::BindTexture(0, GL_TEXTURE_2D_ARRAY, m_RendererID);
+  GLCall(glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, m_Width, m_Height, 1,
+                         GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+  RenderStats::Get().TextureBytes += (unsigned long long)m_Width * m_Height * 4;
+}
+
+bool TextureArray::LoadLayer(int layer, const std::string &path) {
+  // OpenGL expects texture pixels to start at the bottom left
+  stbi_set_flip_vertically_on_load(1);
+  int width, height, bpp;
+  unsigned char *pixels = stbi_load(path.c_str(), &width, &height, &bpp, 4);
+  if (!pixels) {
+    std::cout << "Error: failed to load " << path << ": " << stbi_failure_reason()
+              << std::endl;
+    return false;
+  }
+  bool matches = width == m_Width && height == m_Height;
+  if (matches) {
+    SetLayer(layer, pixels);
+  } else {
+    std::cout << "Error: " << path << " is " << width << "x" << height
+              << ", texture array layers are " << m_Width << "x" << m_Height << std::endl;
+  }
+  stbi_image_free(pixels);
+  return matches;
+}
+
+void TextureArray::Bind(unsigned int slot) const {
+  GLState::BindTexture(slot, GL_TEXTURE_2D_ARRAY, m_RendererID);
+}
+
+void TextureArray::Unbind(unsigned int slot) const {
+  GLState::BindTexture(slot, GL_TEXTURE_2D_ARRAY, 0);
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Renderer.h"
+
+#include <string>
+#include <vector>
+
+// GL_TEXTURE_2D_ARRAY of same-size RGBA8 images. The shader picks the layer
+// per vertex or instance, so one bind covers every image without the padding
+// and bleeding concerns of an atlas.
+class TextureArray {
+public:
+  // Empty layers, filled with SetLayer
+  TextureArray(int width, int height, int layers);
+  // One layer per image; every image must match the size of the first
+  TextureArray(const std::vector<std::string> &paths);
+  ~TextureArray();
+
+  // Tightly packed RGBA8 pixels, bottom row first
+  void SetLayer(int layer, const unsigned char *pixels);
+  bool LoadLayer(int layer, const std::string &path);
+
+  void Bind(unsigned int slot = 0) const;
+  void Unbind(unsigned int slot = 0) const;
+
+  inline int GetWidth() const { return m_Width; }
+  inline int GetHeight() const { return m_Height; }
+  inline int GetLayerCount() const { return m_Layers; }
+  inline unsigned int GetRendererID() const { return m_RendererID; }
+
+private:
+  void Create();
+
+  unsigned int m_RendererID;
+  int m_Width, m_Height, m_Layers;
+};
@@ -0,0 +1,39 @@
+#include "TextureAtlas.h"
+
+#include "Renderer.h"
+
+TextureAtlas::TextureAtlas(const AtlasData &data) {
+  Create(data);
+}
+
+TextureAtlas::TextureAtlas(const std::string &path) {
+  int maxTextureSize;
+  GLCall(glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize));
+  AtlasData data;
+  if (data.Load(path, maxTextureSize)) {
+    Create(data);
+  }
+}
+
+void TextureAtlas::Create(const AtlasData &data) {
+  for (const std::vector<unsigned char> &page : data.Pages) {
+    m_Pages.push_back(std::make_unique<Texture>(data.PageSize, data.PageSize, page.data()));
+  }
+
+  float scale = 1.0f / data.PageSize;
+  for (const AtlasData::Region &region : data.Regions) {
+    TextureRegion textureRegion;
+    textureRegion.Source = m_Pages[region.Page].get();
+    textureRegion.UVMin = glm::vec2(region.X, region.Y) * scale;
+    textureRegion.UVMax = glm::vec2(region.X + region.Width, region.Y + region.Height) * scale;
+    m_RegionIndex[region.Name] = m_Regions.size();
+    m_Regions.push_back(textureRegion);
+  }
+}
+
+const TextureRegion *TextureAtlas::Find(const std::string &name) const {
+  auto it = m_RegionIndex.find(name);
+  if (it == m_RegionIndex.end())
+    return nullptr;
+  return &m_Regions[it->second];
+}
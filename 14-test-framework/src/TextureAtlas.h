@@ -0,0 +1,34 @@
+#pragma once
+
+#include "AtlasBuilder.h"
+#include "Texture.h"
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// GL side of an atlas: one Texture per page and a TextureRegion per sprite.
+// Sprites on the same page share a texture, so BatchRenderer can draw them
+// without breaking the batch.
+class TextureAtlas {
+public:
+  TextureAtlas(const AtlasData &data);
+  // Loads a file written by atlas-packer
+  TextureAtlas(const std::string &path);
+
+  // nullptr if no sprite has that name
+  const TextureRegion *Find(const std::string &name) const;
+
+  // In the order of AtlasData::Regions
+  inline const std::vector<TextureRegion> &GetRegions() const { return m_Regions; }
+  inline int GetPageCount() const { return m_Pages.size(); }
+  inline const Texture &GetPage(int page) const { return *m_Pages[page]; }
+
+private:
+  void Create(const AtlasData &data);
+
+  std::vector<std::unique_ptr<Texture>> m_Pages;
+  std::vector<TextureRegion> m_Regions;
+  std::unordered_map<std::string, int> m_RegionIndex;
+};
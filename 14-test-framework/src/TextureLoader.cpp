@@ -0,0 +1,181 @@
+#include "TextureLoader.h"
+#include "Profiler.h"
+#include "RenderStats.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#include "stb_image/stb_image.h"
+
+TextureLoader::TextureLoader(unsigned int workerCount, unsigned int uploadBudget)
+    : m_PixelBuffer(0), m_UploadBudget(uploadBudget), m_UploadedBytes(0),
+      m_Pending(0), m_Cancelled(false), m_Pool(workerCount) {
+  // The flip flag is global in stb_image, so set it here once rather than
+  // from the workers. Texture sets the same value.
+  stbi_set_flip_vertically_on_load(1);
+
+  GLCall(glGenBuffers(1, &m_PixelBuffer));
+}
+
+TextureLoader::~TextureLoader() {
+  // Skip queued decodes; the pool joins before the members are torn down
+  m_Cancelled = true;
+  m_Pool.Wait();
+
+  for (Request &request : m_Decoded) {
+    stbi_image_free(request.Pixels);
+  }
+  for (Request &request : m_Uploads) {
+    stbi_image_free(request.Pixels);
+    if (request.RendererID) {
+      GLState::OnDeleteTexture(request.RendererID);
+      GLCall(glDeleteTextures(1, &request.RendererID));
+    }
+  }
+
+  GLState::OnDeleteBuffer(m_PixelBuffer);
+  GLCall(glDeleteBuffers(1, &m_PixelBuffer));
+}
+
+std::shared_ptr<Texture> TextureLoader::Load(const std::string &path) {
+  // Mid grey stand-in until the real pixels are resident
+  const unsigned char placeholder[4] = {128, 128, 128, 255};
+  std::shared_ptr<Texture> texture = std::make_shared<Texture>(1, 1, placeholder);
+  texture->m_FilePath = path;
+  texture->m_Resident = false;
+
+  Request request = {texture, path, nullptr, 0, 0, 0, 0};
+  m_Pending++;
+  m_Pool.Submit([this, request]() { Decode(request); });
+  return texture;
+}
+
+void TextureLoader::Decode(Request request) {
+  PROFILE_SCOPE("TextureLoader::Decode");
+  if (m_Cancelled || request.Target.expired()) {
+    m_Pending--;
+    return;
+  }
+
+  int bpp;
+  request.Pixels = stbi_load(request.Path.c_str(), &request.Width,
+                             &request.Height, &bpp, 4); // RGBA so 4 channels
+  if (!request.Pixels) {
+    std::cout << "Warning: failed to load texture " << request.Path << ": "
+              << stbi_failure_reason() << std::endl;
+    m_Pending--;
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(m_DecodedMutex);
+  m_Decoded.push_back(std::move(request));
+}
+
+void TextureLoader::Update() {
+  PROFILE_SCOPE("TextureLoader::Update");
+  {
+    std::lock_guard<std::mutex> lock(m_DecodedMutex);
+    for (Request &request : m_Decoded) {
+      m_Uploads.push_back(std::move(request));
+    }
+    m_Decoded.clear();
+  }
+
+  // Plan this frame's rows, oldest request first. A row is never split, and at
+  // least one row goes up each frame so huge images still make progress.
+  m_Chunks.clear();
+  size_t total = 0;
+  for (Request &request : m_Uploads) {
+    if (request.Target.expired())
+      continue;
+
+    size_t rowBytes = (size_t)request.Width * 4;
+    int rows = request.Height - request.RowsUploaded;
+    int fit = total < m_UploadBudget ? (m_UploadBudget - total) / rowBytes : 0;
+    if (fit == 0) {
+      if (total > 0)
+        break;
+      fit = 1;
+    }
+    rows = std::min(rows, fit);
+
+    m_Chunks.push_back({&request, request.RowsUploaded, rows, total});
+    total += rows * rowBytes;
+  }
+  m_UploadedBytes = total;
+
+  if (!m_Chunks.empty()) {
+    UploadChunks(total);
+  }
+
+  // Hand finished textures over and drop the ones nobody holds anymore
+  auto done = std::remove_if(m_Uploads.begin(), m_Uploads.end(), [this](Request &request) {
+    std::shared_ptr<Texture> target = request.Target.lock();
+    if (target && request.RowsUploaded < request.Height)
+      return false;
+
+    if (target) {
+      target->Adopt(request.RendererID, request.Width, request.Height);
+    } else if (request.RendererID) {
+      GLState::OnDeleteTexture(request.RendererID);
+      GLCall(glDeleteTextures(1, &request.RendererID));
+    }
+    stbi_image_free(request.Pixels);
+    m_Pending--;
+    return true;
+  });
+  m_Uploads.erase(done, m_Uploads.end());
+}
+
+void TextureLoader::UploadChunks(size_t total) {
+  // Allocate storage before the unpack buffer is bound, otherwise the null
+  // pointer would be read as an offset into it
+  for (Chunk &chunk : m_Chunks) {
+    Request &request = *chunk.Source;
+    if (request.RendererID)
+      continue;
+
+    GLCall(glGenTextures(1, &request.RendererID));
+    GLState::BindTexture(0, GL_TEXTURE_2D, request.RendererID);
+    // Same parameters as Texture
+    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
+    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+    GLCall(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, request.Width, request.Height,
+                        0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr));
+  }
+
+  // Orphan and refill the unpack buffer so we never wait on last frame's copy
+  GLState::BindBuffer(GL_PIXEL_UNPACK_BUFFER, m_PixelBuffer);
+  GLCall(glBufferData(GL_PIXEL_UNPACK_BUFFER, total, nullptr, GL_STREAM_DRAW));
+  char *mapped;
+  GLCall(mapped = (char *)glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, total,
+                                           GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+  if (mapped) {
+    for (const Chunk &chunk : m_Chunks) {
+      const Request &request = *chunk.Source;
+      size_t rowBytes = (size_t)request.Width * 4;
+      std::memcpy(mapped + chunk.Offset, request.Pixels + chunk.FirstRow * rowBytes,
+                  chunk.RowCount * rowBytes);
+    }
+    GLCall(glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER));
+
+    // The copies read from the buffer asynchronously
+    for (const Chunk &chunk : m_Chunks) {
+      Request &request = *chunk.Source;
+      GLState::BindTexture(0, GL_TEXTURE_2D, request.RendererID);
+      GLCall(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, chunk.FirstRow, request.Width,
+                             chunk.RowCount, GL_RGBA, GL_UNSIGNED_BYTE,
+                             (const void *)chunk.Offset));
+      request.RowsUploaded += chunk.RowCount;
+    }
+    RenderStats::Get().TextureBytes += total;
+  } else {
+    std::cout << "Warning: failed to map texture upload buffer" << std::endl;
+    m_UploadedBytes = 0;
+  }
+  GLState::BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+  GLState::BindTexture(0, GL_TEXTURE_2D, 0);
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "Texture.h"
+#include "ThreadPool.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Loads textures without stalling the frame. Images are decoded by stb_image
+// on a worker pool; the render thread then streams the pixels to GL through a
+// pixel unpack buffer, never spending more than the upload budget per frame.
+// Load returns straight away with a placeholder that becomes the real texture
+// once all of its rows are resident.
+class TextureLoader {
+public:
+  // workerCount 0 picks a thread per spare core
+  TextureLoader(unsigned int workerCount = 0,
+                unsigned int uploadBudget = 4 * 1024 * 1024);
+  ~TextureLoader();
+
+  std::shared_ptr<Texture> Load(const std::string &path);
+
+  // Call once per frame from the GL thread
+  void Update();
+
+  inline void SetUploadBudget(unsigned int bytes) { m_UploadBudget = bytes; }
+  inline unsigned int GetUploadBudget() const { return m_UploadBudget; }
+  // Textures that are still decoding or uploading
+  inline unsigned int GetPendingCount() const { return m_Pending; }
+  // Bytes copied to GL by the last Update
+  inline unsigned int GetUploadedBytes() const { return m_UploadedBytes; }
+
+private:
+  struct Request {
+    std::weak_ptr<Texture> Target;
+    std::string Path;
+    unsigned char *Pixels;
+    int Width, Height;
+    unsigned int RendererID; // 0 until storage is allocated
+    int RowsUploaded;
+  };
+
+  struct Chunk {
+    Request *Source;
+    int FirstRow, RowCount;
+    size_t Offset; // Into the unpack buffer
+  };
+
+  void Decode(Request request);
+  void UploadChunks(size_t total);
+
+  unsigned int m_PixelBuffer;
+  unsigned int m_UploadBudget, m_UploadedBytes;
+  std::atomic<unsigned int> m_Pending;
+  std::atomic<bool> m_Cancelled;
+
+  std::mutex m_DecodedMutex;
+  std::vector<Request> m_Decoded; // Filled by workers
+  std::vector<Request> m_Uploads; // Render thread only
+  std::vector<Chunk> m_Chunks;
+
+  // Last so it is joined before the queues above are destroyed
+  ThreadPool m_Pool;
+};
@@ -0,0 +1,63 @@
+#include "ThreadPool.h"
+#include "Profiler.h"
+
+ThreadPool::ThreadPool(unsigned int threadCount) : m_Running(0), m_Stopping(false) {
+  if (threadCount == 0) {
+    unsigned int cores = std::thread::hardware_concurrency();
+    threadCount = cores > 1 ? cores - 1 : 1;
+  }
+  for (unsigned int i = 0; i < threadCount; i++) {
+    m_Threads.emplace_back(&ThreadPool::WorkerLoop, this);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Stopping = true;
+  }
+  m_JobAvailable.notify_all();
+  for (std::thread &thread : m_Threads) {
+    thread.join();
+  }
+}
+
+void ThreadPool::Submit(std::function<void()> job) {
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Jobs.push_back(std::move(job));
+  }
+  m_JobAvailable.notify_one();
+}
+
+void ThreadPool::Wait() {
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  m_JobsDone.wait(lock, [this] { return m_Jobs.empty() && m_Running == 0; });
+}
+
+void ThreadPool::WorkerLoop() {
+  Profiler::SetThreadName("Worker");
+  for (;;) {
+    std::function<void()> job;
+    {
+      std::unique_lock<std::mutex> lock(m_Mutex);
+      m_JobAvailable.wait(lock, [this] { return m_Stopping || !m_Jobs.empty(); });
+      if (m_Jobs.empty()) {
+        return; // Stopping and drained
+      }
+      job = std::move(m_Jobs.front());
+      m_Jobs.pop_front();
+      m_Running++;
+    }
+
+    job();
+
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      m_Running--;
+      if (m_Jobs.empty() && m_Running == 0) {
+        m_JobsDone.notify_all();
+      }
+    }
+  }
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads running submitted jobs in FIFO order. Jobs must
+// not touch OpenGL; only the thread owning the context may do that.
+class ThreadPool {
+public:
+  // 0 picks one thread per core, leaving one for the render thread
+  ThreadPool(unsigned int threadCount = 0);
+  // Finishes queued jobs, then joins the workers
+  ~ThreadPool();
+
+  void Submit(std::function<void()> job);
+
+  // Block until every submitted job has finished
+  void Wait();
+
+  inline unsigned int GetThreadCount() const { return m_Threads.size(); }
+
+private:
+  void WorkerLoop();
+
+  std::vector<std::thread> m_Threads;
+  std::deque<std::function<void()>> m_Jobs;
+  std::mutex m_Mutex;
+  std::condition_variable m_JobAvailable, m_JobsDone;
+  unsigned int m_Running;
+  bool m_Stopping;
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstring>
+
+#include <glm/glm.hpp>
+
+// Computes member offsets of a std140 uniform block, in declaration order.
+// Push returns the offset to write the member at; GetSize is the size to
+// allocate for one block.
+//   UniformBlockLayout layout;
+//   unsigned int model = layout.Push<glm::mat4>();
+//   unsigned int tint = layout.Push<glm::vec4>();
+class UniformBlockLayout {
+private:
+  unsigned int m_Size;
+
+  static unsigned int Align(unsigned int value, unsigned int alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+  }
+
+  unsigned int Add(unsigned int size, unsigned int alignment, unsigned int count) {
+    // Array elements are each padded out to a vec4
+    unsigned int stride = size;
+    if (count > 1) {
+      stride = Align(size, 16);
+      alignment = Align(alignment, 16);
+    }
+    unsigned int offset = Align(m_Size, alignment);
+    m_Size = offset + stride * count;
+    return offset;
+  }
+
+public:
+  UniformBlockLayout() : m_Size(0) {}
+
+  // Specialized below for the supported types
+  template <typename T> unsigned int Push(unsigned int count = 1);
+
+  // The block itself is padded to a multiple of a vec4
+  inline unsigned int GetSize() const { return Align(m_Size, 16); }
+
+  // Copy a member into mapped block memory. vec3 writes 12 bytes; the
+  // remaining 4 of its slot are padding.
+  template <typename T>
+  static void Write(void *block, unsigned int offset, const T &value) {
+    std::memcpy((char *)block + offset, &value, sizeof(T));
+  }
+};
+
+template <> inline unsigned int UniformBlockLayout::Push<float>(unsigned int count) {
+  return Add(4, 4, count);
+}
+
+template <> inline unsigned int UniformBlockLayout::Push<int>(unsigned int count) {
+  return Add(4, 4, count);
+}
+
+template <> inline unsigned int UniformBlockLayout::Push<glm::vec2>(unsigned int count) {
+  return Add(8, 8, count);
+}
+
+template <> inline unsigned int UniformBlockLayout::Push<glm::vec3>(unsigned int count) {
+  return Add(12, 16, count);
+}
+
+template <> inline unsigned int UniformBlockLayout::Push<glm::vec4>(unsigned int count) {
+  return Add(16, 16, count);
+}
+
+// Column major: four vec4 columns
+template <> inline unsigned int UniformBlockLayout::Push<glm::mat4>(unsigned int count) {
+  return Add(64, 16, count);
+}
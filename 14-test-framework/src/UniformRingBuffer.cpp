@@ -0,0 +1,106 @@
+#include "UniformRingBuffer.h"
+#include "RenderStats.h"
+
+#include <algorithm>
+#include <iostream>
+
+#include "Renderer.h"
+
+UniformRingBuffer::UniformRingBuffer(unsigned int frameSize, unsigned int frameCount)
+    : m_RendererID(0), m_FrameCount(frameCount), m_Alignment(256),
+      m_Frame(frameCount - 1), m_Head(0), m_Mapped(nullptr),
+      m_Fences(frameCount, nullptr) {
+  int alignment;
+  GLCall(glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment));
+  m_Alignment = alignment;
+  // Keep every region start aligned
+  m_FrameSize = (frameSize + m_Alignment - 1) / m_Alignment * m_Alignment;
+  unsigned int size = m_FrameSize * m_FrameCount;
+
+  GLCall(glGenBuffers(1, &m_RendererID));
+  GLState::BindBuffer(GL_UNIFORM_BUFFER, m_RendererID);
+  if (GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage) {
+    GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    GLCall(glBufferStorage(GL_UNIFORM_BUFFER, size, nullptr, flags));
+    GLCall(m_Mapped = (char *)glMapBufferRange(GL_UNIFORM_BUFFER, 0, size, flags));
+  } else {
+    GLCall(glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_DYNAMIC_DRAW));
+    m_Staging.resize(size);
+    m_Uploaded.resize(m_FrameSize / m_Alignment);
+  }
+}
+
+UniformRingBuffer::~UniformRingBuffer() {
+  for (GLsync fence : m_Fences) {
+    if (fence) {
+      GLCall(glDeleteSync(fence));
+    }
+  }
+  if (m_Mapped) {
+    GLState::BindBuffer(GL_UNIFORM_BUFFER, m_RendererID);
+    GLCall(glUnmapBuffer(GL_UNIFORM_BUFFER));
+  }
+  GLState::OnDeleteBuffer(m_RendererID);
+  GLCall(glDeleteBuffers(1, &m_RendererID));
+}
+
+void UniformRingBuffer::BeginFrame() {
+  m_Frame = (m_Frame + 1) % m_FrameCount;
+  m_Head = 0;
+  std::fill(m_Uploaded.begin(), m_Uploaded.end(), 0);
+
+  GLsync &fence = m_Fences[m_Frame];
+  if (fence) {
+    // Normally signalled long ago; only a GPU several frames behind waits here
+    GLenum result;
+    do {
+      GLCall(result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000));
+    } while (result == GL_TIMEOUT_EXPIRED);
+    GLCall(glDeleteSync(fence));
+    fence = nullptr;
+  }
+}
+
+void UniformRingBuffer::EndFrame() {
+  if (m_Mapped) {
+    GLCall(m_Fences[m_Frame] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+  }
+}
+
+UniformRingBuffer::Allocation UniformRingBuffer::Allocate(unsigned int size) {
+  Allocation allocation;
+  unsigned int offset = (m_Head + m_Alignment - 1) / m_Alignment * m_Alignment;
+  if (offset + size > m_FrameSize) {
+    std::cout << "Warning: uniform ring buffer frame region is full" << std::endl;
+    return allocation;
+  }
+  m_Head = offset + size;
+  RenderStats::Get().BufferBytes += size;
+
+  allocation.Offset = m_Frame * m_FrameSize + offset;
+  allocation.Size = size;
+  allocation.Data = (m_Mapped ? m_Mapped : m_Staging.data()) + allocation.Offset;
+  return allocation;
+}
+
+void UniformRingBuffer::Upload(const Allocation &allocation) {
+  // Blocks start on alignment boundaries, so this indexes one per block
+  char &uploaded = m_Uploaded[(allocation.Offset - m_Frame * m_FrameSize) / m_Alignment];
+  if (uploaded) {
+    return; // Already bound this frame; shared blocks are sent once
+  }
+  GLState::BindBuffer(GL_UNIFORM_BUFFER, m_RendererID);
+  GLCall(glBufferSubData(GL_UNIFORM_BUFFER, allocation.Offset, allocation.Size,
+                         m_Staging.data() + allocation.Offset));
+  uploaded = 1;
+}
+
+void UniformRingBuffer::Bind(unsigned int binding, const Allocation &allocation) {
+  if (!allocation.Data) {
+    return; // Failed allocation; a zero sized range is GL_INVALID_VALUE
+  }
+  if (!m_Mapped) {
+    Upload(allocation);
+  }
+  GLState::BindUniformBufferRange(binding, m_RendererID, allocation.Offset, allocation.Size);
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <vector>
+
+#include <GL/glew.h>
+
+// One large GL_UNIFORM_BUFFER split into per-frame regions. Each frame,
+// blocks are bump-allocated from the current region, written through the
+// returned pointer and bound by offset with glBindBufferRange, so data shared
+// by many draws or programs is written once.
+//
+// With GL 4.4 / ARB_buffer_storage the buffer is persistently mapped and a
+// fence per region keeps the CPU from overwriting data the GPU may still be
+// reading. Otherwise writes go to a CPU copy, and each block is uploaded with
+// glBufferSubData the first time it is bound, so it may be written any time
+// before its own Bind even if other blocks were bound in between.
+class UniformRingBuffer {
+public:
+  struct Allocation {
+    void *Data = nullptr; // Write the block here before binding it
+    unsigned int Offset = 0;
+    unsigned int Size = 0;
+  };
+
+  UniformRingBuffer(unsigned int frameSize, unsigned int frameCount = 3);
+  ~UniformRingBuffer();
+
+  // Move to the next region, waiting if the GPU is still using it
+  void BeginFrame();
+  // Fence the current region; call after the frame's last draw using it
+  void EndFrame();
+
+  // Data is nullptr if the frame's region is full
+  Allocation Allocate(unsigned int size);
+  // Does nothing for a failed allocation
+  void Bind(unsigned int binding, const Allocation &allocation);
+
+  inline bool IsPersistent() const { return m_Mapped != nullptr; }
+
+private:
+  void Upload(const Allocation &allocation);
+
+  unsigned int m_RendererID;
+  unsigned int m_FrameSize, m_FrameCount, m_Alignment;
+  unsigned int m_Frame;
+  unsigned int m_Head;     // Bytes allocated in the current region
+  // Per alignment unit of the current region, whether the block starting
+  // there has been uploaded; fallback path only
+  std::vector<char> m_Uploaded;
+  char *m_Mapped;
+  std::vector<char> m_Staging;
+  std::vector<GLsync> m_Fences;
+};
@@ -1,32 +1,53 @@
 #include "Renderer.h"
 
-VertexArray::VertexArray() {
+VertexArray::VertexArray() : m_AttribCount(0), m_BaseInstance(0) {
   GLCall(glGenVertexArrays(1, &m_RendererID));
 }
 
 VertexArray::~VertexArray() {
+    GLState::OnDeleteVertexArray(m_RendererID);
     GLCall(glDeleteVertexArrays(1, &m_RendererID));
 }
 
 void VertexArray::AddBuffer(const VertexBuffer &vb,
                             const VertexBufferLayout &layout) {
-                                  GLCall(glBindVertexArray(m_RendererID));
   Bind();
   vb.Bind();
   const auto &elements = layout.GetElements();
   unsigned int offset = 0;
   for (unsigned int i = 0; i < elements.size(); i++) {
       const auto& element = elements[i];
-    GLCall(glEnableVertexAttribArray(i));
+      unsigned int location = m_AttribCount + i;
+    GLCall(glEnableVertexAttribArray(location));
     GLCall(
-        glVertexAttribPointer(i, element.count, element.type, element.normalized, layout.GetStride(), (const void*)(intptr_t)offset)); 
+        glVertexAttribPointer(location, element.count, element.type, element.normalized, layout.GetStride(), (const void*)(intptr_t)offset)); 
+    if (element.divisor) {
+      GLCall(glVertexAttribDivisor(location, element.divisor));
+      m_InstanceAttribs.push_back({vb.GetRendererID(), location, element, layout.GetStride(), offset});
+    }
     offset += element.count * VertexBufferElement::GetSizeOfType(element.type);
   }
+  m_AttribCount += elements.size();
+}
+
+void VertexArray::SetBaseInstance(unsigned int baseInstance) const {
+  Bind();
+  if (baseInstance == m_BaseInstance)
+    return;
+  // Instance i of any divisor reads element baseInstance + i / divisor, so
+  // moving the attribute start by baseInstance elements is the same thing
+  for (const InstanceAttrib &attrib : m_InstanceAttribs) {
+    GLState::BindBuffer(GL_ARRAY_BUFFER, attrib.Buffer);
+    const void *offset = (const void *)(intptr_t)(attrib.Offset + (size_t)baseInstance * attrib.Stride);
+    GLCall(glVertexAttribPointer(attrib.Location, attrib.Element.count, attrib.Element.type,
+                                 attrib.Element.normalized, attrib.Stride, offset));
+  }
+  m_BaseInstance = baseInstance;
 }
 
 void VertexArray::Bind() const {
-    GLCall(glBindVertexArray(m_RendererID));
+    GLState::BindVertexArray(m_RendererID);
 }
 void VertexArray::Unbind() const {
-    GLCall(glBindVertexArray(0));
-}
\ No newline at end of file
+    GLState::BindVertexArray(0);
+}
@@ -6,13 +6,30 @@
 class VertexArray {
     private:
     unsigned int m_RendererID;
+    unsigned int m_AttribCount; // Next free attribute location
+
+    // Per-instance attributes, kept so SetBaseInstance can re-point them
+    struct InstanceAttrib {
+        unsigned int Buffer, Location;
+        VertexBufferElement Element;
+        unsigned int Stride, Offset;
+    };
+    std::vector<InstanceAttrib> m_InstanceAttribs;
+    mutable unsigned int m_BaseInstance;
 
     public:
         VertexArray();
         ~VertexArray();
 
+        // Attributes of each added buffer continue from the locations used by
+        // the previous ones, so a per-vertex buffer followed by a per-instance
+        // buffer maps onto consecutive shader locations
         void AddBuffer(const VertexBuffer& vb, const VertexBufferLayout& layout);
 
+        // Start per-instance attributes at instance baseInstance, for drivers
+        // without GL 4.2 / ARB_base_instance. Binds this VAO.
+        void SetBaseInstance(unsigned int baseInstance) const;
+
         void Bind() const;
         void Unbind() const;
-};
\ No newline at end of file
+};
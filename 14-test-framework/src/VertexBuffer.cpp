@@ -1,21 +1,40 @@
 #include "VertexBuffer.h"
 
 #include "Renderer.h"
+#include "RenderStats.h"
 
 VertexBuffer::VertexBuffer(const void *data, unsigned int size) {
   GLCall(glGenBuffers(1, &m_RendererID));
-  GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_RendererID));
+  GLState::BindBuffer(GL_ARRAY_BUFFER, m_RendererID);
   GLCall(glBufferData(GL_ARRAY_BUFFER, size, data, GL_STATIC_DRAW));
+  RenderStats::Get().BufferBytes += size;
+}
+
+VertexBuffer::VertexBuffer() {
+  GLCall(glGenBuffers(1, &m_RendererID));
+}
+
+VertexBuffer::VertexBuffer(unsigned int size) {
+  GLCall(glGenBuffers(1, &m_RendererID));
+  GLState::BindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+  GLCall(glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_DYNAMIC_DRAW));
 }
 
 VertexBuffer::~VertexBuffer() {
+    GLState::OnDeleteBuffer(m_RendererID);
     GLCall(glDeleteBuffers(1, &m_RendererID)); 
 }
 
+void VertexBuffer::SetData(const void *data, unsigned int size, unsigned int offset) {
+  GLState::BindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+  GLCall(glBufferSubData(GL_ARRAY_BUFFER, offset, size, data));
+  RenderStats::Get().BufferBytes += size;
+}
+
 void VertexBuffer::Bind() const {
-    GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_RendererID));
+    GLState::BindBuffer(GL_ARRAY_BUFFER, m_RendererID);
 }
  
 void VertexBuffer::Unbind() const {
-    GLCall(glBindBuffer(GL_ARRAY_BUFFER, 0));
-}
\ No newline at end of file
+    GLState::BindBuffer(GL_ARRAY_BUFFER, 0);
+}
@@ -1,13 +1,23 @@
 #pragma once
 
 class VertexBuffer {
-private:
+protected:
   unsigned int m_RendererID;
 
+  // Generates the buffer name only; the subclass allocates storage
+  VertexBuffer();
+
 public:
     VertexBuffer(const void* data, unsigned int size);
+    // Dynamic buffer of the given size; contents are supplied later by SetData
+    VertexBuffer(unsigned int size);
     ~VertexBuffer();
 
+    // Overwrite size bytes from offset; the range must lie in the allocation
+    void SetData(const void* data, unsigned int size, unsigned int offset = 0);
+
     void Bind() const;
     void Unbind() const;
-};
\ No newline at end of file
+
+    inline unsigned int GetRendererID() const { return m_RendererID; }
+};
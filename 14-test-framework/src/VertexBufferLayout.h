@@ -11,6 +11,7 @@ struct VertexBufferElement {
   unsigned int type;
   unsigned int count;
   unsigned char normalized;
+  unsigned int divisor; // 0 = per vertex, N = advance once every N instances
 
   static unsigned int GetSizeOfType(unsigned int type) {
     switch (type) {
@@ -39,7 +40,7 @@ public:
    * Workaround is to have template specializations outside class scope (bottom
    * of this header)*/
   template<typename T> 
-  void Push(unsigned int count) {
+  void Push(unsigned int count, unsigned int divisor = 0) {
     std::cout << "Error: unsupported type " << typeid(T).name() << std::endl;
     //TODO: DEBUG_BREAK;
   }
@@ -51,20 +52,20 @@ public:
 };
 
   template<> 
-  inline void VertexBufferLayout::Push<float>(unsigned int count) {
-    m_Elements.push_back({GL_FLOAT, count, GL_FALSE});
+  inline void VertexBufferLayout::Push<float>(unsigned int count, unsigned int divisor) {
+    m_Elements.push_back({GL_FLOAT, count, GL_FALSE, divisor});
     m_Stride += count * VertexBufferElement::GetSizeOfType(GL_FLOAT);
   }
 
   template<> 
-  inline void VertexBufferLayout::Push<unsigned int>(unsigned int count) {
-    m_Elements.push_back({GL_UNSIGNED_INT, count, GL_FALSE});
+  inline void VertexBufferLayout::Push<unsigned int>(unsigned int count, unsigned int divisor) {
+    m_Elements.push_back({GL_UNSIGNED_INT, count, GL_FALSE, divisor});
     m_Stride += count * VertexBufferElement::GetSizeOfType(GL_UNSIGNED_INT);
   }
 
   template<>
-  inline void VertexBufferLayout::Push<unsigned char>(unsigned int count) {
-    m_Elements.push_back({GL_UNSIGNED_BYTE, count, GL_TRUE});
+  inline void VertexBufferLayout::Push<unsigned char>(unsigned int count, unsigned int divisor) {
+    m_Elements.push_back({GL_UNSIGNED_BYTE, count, GL_TRUE, divisor});
     m_Stride += count * VertexBufferElement::GetSizeOfType(GL_UNSIGNED_BYTE);
   }
   
\ No newline at end of file
@@ -5,10 +5,19 @@
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <sstream>
 
 #include "Renderer.h"
+#include "AssetPack.h"
+#include "GLDebug.h"
+#include "Benchmark.h"
+#include "FrameClock.h"
+#include "Profiler.h"
+#include "GPUProfiler.h"
+#include "RenderStats.h"
+#include "RenderThread.h"
 
 #include "VertexBuffer.h"
 #include "IndexBuffer.h"
@@ -26,13 +35,56 @@
 #include "tests/Test.h"
 #include "tests/TestClearColor.h"
 #include "tests/TestTexture2D.h"
+#include "tests/TestBatchRendering.h"
+#include "tests/TestInstancing.h"
+#include "tests/TestShaderCompile.h"
+#include "tests/TestUniformBuffer.h"
+#include "tests/TestAsyncTextures.h"
+#include "tests/TestTextureAtlas.h"
+#include "tests/TestTextureArray.h"
+#include "tests/TestMipmaps.h"
+#include "tests/TestCompressedTextures.h"
+#include "tests/TestRenderQueue.h"
+#include "tests/TestParallelCommands.h"
+#include "tests/TestMultiDrawIndirect.h"
+#include "tests/TestGeometryArena.h"
 
 void error_callback(int error, const char *description);
+static void register_tests(test::TestMenu *testMenu);
 static void key_callback(GLFWwindow *window, int key, int scancode, int action,
                          int mods);
 
 int main(int argc, char **argv) {
   glfwSetErrorCallback(error_callback);
+  Profiler::SetThreadName("Main");
+
+  Benchmark::Options benchmarkOptions;
+  if (!Benchmark::ParseArgs(argc, argv, benchmarkOptions)) {
+    std::cout << "Usage: " << argv[0] << " [--benchmark [--frames N] [--warmup N] "
+              << "[--size WxH] [--test NAME]... [--output FILE]]" << std::endl;
+    return -1;
+  }
+
+  // Benchmark results may go to stdout, so in that mode every line logged
+  // through std::cout (here, in the wrappers and in the tests) goes to stderr
+  std::ostream results(std::cout.rdbuf());
+  if (benchmarkOptions.Enabled) {
+    std::cout.rdbuf(std::cerr.rdbuf());
+  }
+
+  // Packed assets (tools/AssetPacker.cpp) replace the loose files under res/
+  if (std::ifstream("res/assets.pack").good()) {
+    AssetPack::Mount("res/assets.pack");
+  }
+
+  if (benchmarkOptions.Enabled) {
+    test::Test* currentTest = nullptr;
+    test::TestMenu testMenu(currentTest);
+    register_tests(&testMenu);
+    int exitCode = Benchmark::Run(testMenu, benchmarkOptions, results);
+    std::cout.rdbuf(results.rdbuf());
+    return exitCode;
+  }
 
   if (!glfwInit()) {
     std::cout << "Error: Failed to initialize GLFW.\n";
@@ -43,6 +95,9 @@ int main(int argc, char **argv) {
   glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
   glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
   glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+#ifdef GL_ERROR_MODE_DEBUG_OUTPUT
+  glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GLFW_TRUE);
+#endif
 
   int windowX = 960, windowY = 540;
   GLFWwindow *window = glfwCreateWindow(windowX, windowY, "Learn OpenGL", NULL, NULL);
@@ -67,10 +122,13 @@ int main(int argc, char **argv) {
             << std::endl;
   GLCall(std::cout << "Status: Using OpenGL version " << glGetString(GL_VERSION)
                    << std::endl);
+#ifdef GL_ERROR_MODE_DEBUG_OUTPUT
+  GLDebug::Enable();
+#endif
 
   // Alpha transparency blending
-  GLCall(glEnable(GL_BLEND));
-  GLCall(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+  GLState::SetBlend(true);
+  GLState::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
   Renderer renderer;
 
@@ -84,41 +142,202 @@ int main(int argc, char **argv) {
   test::TestMenu* testMenu = new test::TestMenu(currentTest);
   currentTest = testMenu;
 
-  testMenu->RegisterTest<test::TestClearColor>("Clear Color");
-  testMenu->RegisterTest<test::TestTexture2D>("Texture 2D");
+  register_tests(testMenu);
 
-  while (!glfwWindowShouldClose(window)) {
+  FrameClock frameClock;
+  bool fixedTimestep = true;
+  int fixedRate = 60; // Simulation steps per second
+  bool showProfiler = false;
+  bool pipelined = false;
+  // Owns the context while pipelined is on
+  std::unique_ptr<RenderThread> renderThread;
+  // The render thread draws from one while the main thread fills the other
+  ImGuiFrameSnapshot imguiFrames[2];
+  int imguiFrame = 0;
+  // Stats of the last frame the render thread finished, read at the handoff
+  RenderStats pipelinedStats;
+
+  // Runs this frame's simulation and returns how far OnRender should
+  // interpolate between the last two steps
+  auto simulate = [&](float deltaTime) {
+    PROFILE_SCOPE("OnFixedUpdate");
+    if (fixedTimestep) {
+      while (frameClock.StepFixed())
+        currentTest->OnFixedUpdate(frameClock.GetFixedStep());
+      return frameClock.GetAlpha();
+    }
+    frameClock.ResetAccumulator();
+    currentTest->OnFixedUpdate(deltaTime);
+    return 1.0f;
+  };
+
+  // Builds the "Test" window and returns true if the back button was pressed
+  auto testWindow = [&](const RenderStats &stats, bool showGPUPasses) {
+    ImGui::Begin("Test");
+    bool back = currentTest != testMenu && ImGui::Button("<-");
+    {
+      PROFILE_SCOPE("OnImGuiRender");
+      currentTest->OnImGuiRender();
+    }
+    if (ImGui::CollapsingHeader("Render stats", ImGuiTreeNodeFlags_DefaultOpen)) {
+      RenderStats::OnImGuiRender(stats);
+    }
+    ImGui::Checkbox("Fixed timestep", &fixedTimestep);
+    if (fixedTimestep && ImGui::SliderInt("Steps per second", &fixedRate, 10, 240)) {
+      frameClock.SetFixedStep(1.0f / fixedRate);
+    }
+    ImGui::Checkbox("Render thread", &pipelined);
+    if (pipelined && !currentTest->IsPipelined()) {
+      ImGui::SameLine();
+      ImGui::TextDisabled("(not pipelined by this test)");
+    }
+    ImGui::Checkbox("Profiler", &showProfiler);
+    if (ImGui::CollapsingHeader("GPU passes")) {
+      if (showGPUPasses) {
+        GPUProfiler::OnImGuiRender();
+      } else {
+        ImGui::TextDisabled("Not available while pipelined");
+      }
+    }
+    ImGui::End();
+    return back;
+  };
+
+  // One whole frame on whichever thread owns the context
+  auto serialFrame = [&](float deltaTime) {
     GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
     renderer.Clear();
 
     ImGui_ImplOpenGL3_NewFrame();
-    ImGui_ImplGlfw_NewFrame();
     ImGui::NewFrame();
 
     if(currentTest) {
-      currentTest->OnUpdate(0.0f);
-      currentTest->OnRender();
-      ImGui::Begin("Test");
-      if(currentTest != testMenu && ImGui::Button("<-")) {
+      currentTest->SetInterpolation(simulate(deltaTime));
+      {
+        PROFILE_SCOPE("OnUpdate");
+        currentTest->OnUpdate(deltaTime);
+      }
+      currentTest->OnSnapshot();
+      {
+        GPU_PROFILE_SCOPE("OnRender");
+        currentTest->OnRender();
+      }
+      if (testWindow(RenderStats::GetLastFrame(), true)) {
         delete currentTest;
         currentTest = testMenu;
       }
-      currentTest->OnImGuiRender();
-      ImGui::End();
     }
+    if (showProfiler) {
+      Profiler::OnImGuiRender();
+    }
+
+    // Everything after this (the ImGui pass) counts towards the next frame
+    RenderStats::EndFrame();
+
+    {
+      GPU_PROFILE_SCOPE("ImGui");
+      ImGui::Render();
+      ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+    }
+    // The ImGui backend binds its own program, VAO and textures directly
+    GLState::Invalidate();
+    GPUProfiler::EndFrame();
+
+#ifdef GL_ERROR_MODE_DEBUG_OUTPUT
+    GLDebug::Flush();
+#endif
+
+    {
+      PROFILE_SCOPE("SwapBuffers");
+      glfwSwapBuffers(window);
+    }
+  };
+
+  while (!glfwWindowShouldClose(window)) {
+    // Only switch while the render thread is idle; the destructor waits
+    if (pipelined && !renderThread) {
+      renderThread = std::make_unique<RenderThread>(window);
+    } else if (!pipelined && renderThread) {
+      renderThread.reset();
+    }
+
+    float deltaTime = frameClock.Tick();
+
+    // Reads input, so it stays on the main thread
+    ImGui_ImplGlfw_NewFrame();
 
-    ImGui::Render();
-    ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+    if (!renderThread) {
+      serialFrame(deltaTime);
+    } else if (!currentTest || !currentTest->IsPipelined()) {
+      renderThread->Run([&]() { serialFrame(deltaTime); });
+    } else {
+      // Frame N is still being drawn while this builds frame N+1
+      ImGui::NewFrame();
+      float alpha = simulate(deltaTime);
+      {
+        PROFILE_SCOPE("OnUpdate");
+        currentTest->OnUpdate(deltaTime);
+      }
+      bool back = testWindow(pipelinedStats, false);
+      if (showProfiler) {
+        Profiler::OnImGuiRender();
+      }
+      ImGui::Render();
+      ImGuiFrameSnapshot &ui = imguiFrames[imguiFrame];
+      imguiFrame ^= 1;
+      ui.Capture(ImGui::GetDrawData());
+
+      {
+        PROFILE_SCOPE("WaitForRender");
+        renderThread->Wait();
+      }
+      // Neither thread is inside the test until the next Submit
+      pipelinedStats = RenderStats::GetLastFrame();
+      if (back) {
+        renderThread->Run([&]() { delete currentTest; });
+        currentTest = testMenu;
+      } else {
+        currentTest->SetInterpolation(alpha);
+        currentTest->OnSnapshot();
+        test::Test *test = currentTest;
+        renderThread->Submit([&renderer, &ui, test, window]() {
+          GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+          renderer.Clear();
+          {
+            GPU_PROFILE_SCOPE("OnRender");
+            test->OnRender();
+          }
+          RenderStats::EndFrame();
+          {
+            GPU_PROFILE_SCOPE("ImGui");
+            ImGui_ImplOpenGL3_RenderDrawData(ui.GetDrawData());
+          }
+          GLState::Invalidate();
+          GPUProfiler::EndFrame();
+#ifdef GL_ERROR_MODE_DEBUG_OUTPUT
+          GLDebug::Flush();
+#endif
+          {
+            PROFILE_SCOPE("SwapBuffers");
+            glfwSwapBuffers(window);
+          }
+        });
+      }
+    }
 
-    glfwSwapBuffers(window);
     glfwPollEvents();
+    Profiler::EndFrame();
   }
 
+  // Hands the context back to this thread for the cleanup below
+  renderThread.reset();
+
   delete currentTest;
   if (currentTest != testMenu) {
     delete testMenu;
   }
 
+  GPUProfiler::Shutdown();
   ImGui_ImplOpenGL3_Shutdown();
   ImGui_ImplGlfw_Shutdown();
   ImGui::DestroyContext();
@@ -129,6 +348,24 @@ int main(int argc, char **argv) {
   return 0;
 }
 
+static void register_tests(test::TestMenu *testMenu) {
+  testMenu->RegisterTest<test::TestClearColor>("Clear Color");
+  testMenu->RegisterTest<test::TestTexture2D>("Texture 2D");
+  testMenu->RegisterTest<test::TestBatchRendering>("Batch Rendering");
+  testMenu->RegisterTest<test::TestInstancing>("Instancing");
+  testMenu->RegisterTest<test::TestShaderCompile>("Shader Compile");
+  testMenu->RegisterTest<test::TestUniformBuffer>("Uniform Buffers");
+  testMenu->RegisterTest<test::TestAsyncTextures>("Async Textures");
+  testMenu->RegisterTest<test::TestTextureAtlas>("Texture Atlas");
+  testMenu->RegisterTest<test::TestTextureArray>("Texture Array");
+  testMenu->RegisterTest<test::TestMipmaps>("Mipmaps");
+  testMenu->RegisterTest<test::TestCompressedTextures>("Compressed Textures");
+  testMenu->RegisterTest<test::TestRenderQueue>("Render Queue");
+  testMenu->RegisterTest<test::TestParallelCommands>("Parallel Recording");
+  testMenu->RegisterTest<test::TestMultiDrawIndirect>("Multi-Draw Indirect");
+  testMenu->RegisterTest<test::TestGeometryArena>("Geometry Arena");
+}
+
 void error_callback(int error, const char *description) {
   std::cout<< "Error: GLFW error: " << description << std::endl;
 }
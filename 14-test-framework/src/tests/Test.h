@@ -3,6 +3,7 @@
 #include <vector>
 #include <functional>
 #include <iostream>
+#include <string>
 
 namespace test {
     class Test {
@@ -10,9 +11,30 @@ namespace test {
         Test() {}
         virtual ~Test() {}
 
+        // Once per frame with the real frame time in seconds
         virtual void OnUpdate(float deltaTime) {}
+        // Simulation: zero or more fixed steps per frame, or once per frame
+        // with the frame time when the fixed timestep is off
+        virtual void OnFixedUpdate(float step) {}
         virtual void OnRender() {}
         virtual void OnImGuiRender() {}
+
+        // How far between the previous and latest simulation step OnRender
+        // should draw, in [0, 1]
+        void SetInterpolation(float alpha) { m_Interpolation = alpha; }
+
+        // With the render thread on, a pipelined test has OnRender for one
+        // frame run on the render thread while the main thread runs
+        // OnFixedUpdate, OnUpdate and OnImGuiRender for the next. It must keep
+        // what OnRender reads apart from what those write and copy it over in
+        // OnSnapshot, which runs before every OnRender while neither thread is
+        // inside the test. Only OnRender may make GL calls. Other tests run
+        // one frame at a time.
+        virtual bool IsPipelined() const { return false; }
+        virtual void OnSnapshot() {}
+
+        protected:
+        float m_Interpolation = 1.0f;
     };
 
     class TestMenu : public Test{
@@ -26,7 +48,11 @@ namespace test {
             std::cout<< "Status: Registering test " << name << std::endl;
             m_Tests.push_back(std::make_pair(name, []() { return new T();}));
         }
-        
+
+        // nullptr if no test was registered under name
+        Test* CreateTest(const std::string& name) const;
+        std::vector<std::string> GetTestNames() const;
+
         private:
         Test*& m_CurrentTest;
         std::vector<std::pair<std::string, std::function<Test*()>>> m_Tests;
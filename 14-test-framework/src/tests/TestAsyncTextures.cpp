@@ -0,0 +1,71 @@
+#include "TestAsyncTextures.h"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "Renderer.h"
+
+#include "imgui/imgui.h"
+
+namespace test {
+TestAsyncTextures::TestAsyncTextures()
+    : m_Proj(glm::ortho(0.0f, 960.0f, 0.0f, 540.0f, -1.0f, 1.0f)),
+      m_View(glm::mat4(1.0f)), m_TextureCount(64), m_UploadBudgetKB(1024) {
+  // Alpha transparency blending
+  GLState::SetBlend(true);
+  GLState::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+  m_Loader = std::make_unique<TextureLoader>(0, m_UploadBudgetKB * 1024);
+  m_BatchRenderer = std::make_unique<BatchRenderer>();
+  LoadAll();
+}
+
+TestAsyncTextures::~TestAsyncTextures() {}
+
+void TestAsyncTextures::LoadAll() {
+  // Dropping the old handles cancels whatever is still in flight
+  m_Textures.clear();
+  for (int i = 0; i < m_TextureCount; i++) {
+    m_Textures.push_back(m_Loader->Load("res/textures/bowser.png"));
+  }
+}
+
+void TestAsyncTextures::OnUpdate(float deltaTime) {
+  m_Loader->SetUploadBudget(m_UploadBudgetKB * 1024);
+  m_Loader->Update();
+}
+
+void TestAsyncTextures::OnRender() {
+  GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+  GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+  // Square grid filling the window
+  int columns = 1;
+  while (columns * columns < m_TextureCount)
+    columns++;
+  float tile = 540.0f / columns;
+  glm::vec2 size(tile * 0.9f, tile * 0.9f);
+
+  m_BatchRenderer->ResetStats();
+  m_BatchRenderer->Begin(m_Proj * m_View);
+  for (int i = 0; i < (int)m_Textures.size(); i++) {
+    glm::vec2 position(210.0f + (i % columns + 0.5f) * tile,
+                       540.0f - (i / columns + 0.5f) * tile);
+    m_BatchRenderer->DrawQuad(position, size, *m_Textures[i], glm::vec4(1.0f));
+  }
+  m_BatchRenderer->End();
+}
+
+void TestAsyncTextures::OnImGuiRender() {
+  ImGui::SliderInt("Textures", &m_TextureCount, 1, 256);
+  ImGui::SliderInt("Upload budget (KB/frame)", &m_UploadBudgetKB, 64, 16384);
+  if (ImGui::Button("Reload")) {
+    LoadAll();
+  }
+
+  ImGui::Text("Pending: %u, uploaded last frame: %u KB", m_Loader->GetPendingCount(),
+              m_Loader->GetUploadedBytes() / 1024);
+  ImGui::Text("Application average %.3f ms/frame (%.1f FPS)",
+              1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+}
+} // namespace test
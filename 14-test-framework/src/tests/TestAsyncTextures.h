@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Test.h"
+
+#include "BatchRenderer.h"
+#include "TextureLoader.h"
+
+#include <memory>
+#include <vector>
+
+namespace test {
+    class TestAsyncTextures : public Test {
+        public:
+        TestAsyncTextures();
+        ~TestAsyncTextures();
+
+        void OnUpdate(float deltaTime) override;
+        void OnRender() override;
+        void OnImGuiRender() override;
+
+      private:
+        void LoadAll();
+
+        std::unique_ptr<TextureLoader> m_Loader;
+        std::unique_ptr<BatchRenderer> m_BatchRenderer;
+        // One texture per tile, so every load goes through the whole pipeline
+        std::vector<std::shared_ptr<Texture>> m_Textures;
+        glm::mat4 m_Proj, m_View;
+        int m_TextureCount;
+        int m_UploadBudgetKB;
+    };
+    } // namespace test
@@ -0,0 +1,78 @@
+#include "TestBatchRendering.h"
+
+#include <cstdlib>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "Renderer.h"
+#include "TestHelpers.h"
+
+#include "imgui/imgui.h"
+
+namespace test {
+TestBatchRendering::TestBatchRendering()
+    : m_Proj(glm::ortho(0.0f, 960.0f, 0.0f, 540.0f, -1.0f, 1.0f)),
+      m_View(glm::mat4(1.0f)), m_SpriteCount(0), m_SpriteSize(16.0f) {
+  // Alpha transparency blending
+  GLState::SetBlend(true);
+  GLState::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+  m_BatchRenderer = std::make_unique<BatchRenderer>();
+  m_Texture = std::make_unique<Texture>("res/textures/bowser.png");
+  Resize(10000);
+}
+
+TestBatchRendering::~TestBatchRendering() {}
+
+void TestBatchRendering::Resize(int count) {
+  int oldCount = m_SpriteCount;
+  m_Sprites.resize(count);
+  for (int i = oldCount; i < count; i++) {
+    Sprite &sprite = m_Sprites[i];
+    sprite.Position = {RandomFloat(0.0f, 960.0f), RandomFloat(0.0f, 540.0f)};
+    sprite.Velocity = {RandomFloat(-2.0f, 2.0f), RandomFloat(-2.0f, 2.0f)};
+    sprite.Color = {RandomFloat(0.2f, 1.0f), RandomFloat(0.2f, 1.0f),
+                    RandomFloat(0.2f, 1.0f), 1.0f};
+    sprite.Textured = (i % 2) == 0;
+  }
+  m_SpriteCount = count;
+}
+
+void TestBatchRendering::OnFixedUpdate(float step) {
+  for (Sprite &sprite : m_Sprites) {
+    Bounce(sprite.Position, sprite.Velocity, step);
+  }
+}
+
+void TestBatchRendering::OnRender() {
+  GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+  GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+  glm::vec2 size(m_SpriteSize, m_SpriteSize);
+  m_BatchRenderer->ResetStats();
+  m_BatchRenderer->Begin(m_Proj * m_View);
+  for (const Sprite &sprite : m_Sprites) {
+    if (sprite.Textured)
+      m_BatchRenderer->DrawQuad(sprite.Position, size, *m_Texture, sprite.Color);
+    else
+      m_BatchRenderer->DrawQuad(sprite.Position, size, sprite.Color);
+  }
+  m_BatchRenderer->End();
+}
+
+void TestBatchRendering::OnImGuiRender() {
+  int count = m_SpriteCount;
+  if (ImGui::SliderInt("Sprites", &count, 1, 100000)) {
+    Resize(count);
+  }
+  ImGui::SliderFloat("Sprite size", &m_SpriteSize, 1.0f, 100.0f);
+
+  const BatchRenderer::Stats &stats = m_BatchRenderer->GetStats();
+  ImGui::Text("Draw calls: %u, quads: %u", stats.DrawCalls, stats.QuadCount);
+  if (stats.DroppedQuads)
+    ImGui::Text("Dropped quads (frame full): %u", stats.DroppedQuads);
+  ImGui::Text("Application average %.3f ms/frame (%.1f FPS)",
+              1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+}
+} // namespace test
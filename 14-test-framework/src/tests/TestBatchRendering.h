@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Test.h"
+
+#include "BatchRenderer.h"
+#include "Texture.h"
+
+#include <memory>
+#include <vector>
+
+namespace test {
+    class TestBatchRendering : public Test {
+        public:
+        TestBatchRendering();
+        ~TestBatchRendering();
+
+        void OnFixedUpdate(float step) override;
+        void OnRender() override;
+        void OnImGuiRender() override;
+
+      private:
+        struct Sprite {
+            glm::vec2 Position;
+            glm::vec2 Velocity; // pixels per 1/60 s
+            glm::vec4 Color;
+            bool Textured;
+        };
+
+        void Resize(int count);
+
+        std::unique_ptr<BatchRenderer> m_BatchRenderer;
+        std::unique_ptr<Texture> m_Texture;
+        std::vector<Sprite> m_Sprites;
+        glm::mat4 m_Proj, m_View;
+        int m_SpriteCount;
+        float m_SpriteSize;
+    };
+    } // namespace test
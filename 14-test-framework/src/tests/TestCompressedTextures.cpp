@@ -0,0 +1,143 @@
+#include "TestCompressedTextures.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "BlockEncoder.h"
+#include "Renderer.h"
+
+#include "stb_image/stb_image.h"
+
+#include "imgui/imgui.h"
+
+namespace test {
+static double MillisecondsSince(std::chrono::high_resolution_clock::time_point start) {
+  auto end = std::chrono::high_resolution_clock::now();
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+TestCompressedTextures::TestCompressedTextures()
+    : m_Proj(glm::ortho(0.0f, 960.0f, 0.0f, 540.0f, -1.0f, 1.0f)),
+      m_View(glm::mat4(1.0f)), m_Zoom(1.0f) {
+  float positions[] = {
+      -100.0f, -80.0f, 0.0f, 0.0f, // bottom left
+       100.0f, -80.0f, 1.0f, 0.0f, // bottom right
+       100.0f,  80.0f, 1.0f, 1.0f, // top right
+      -100.0f,  80.0f, 0.0f, 1.0f  // top left
+  };
+  unsigned int indices[] = {0, 1, 2, 2, 3, 0};
+
+  // Alpha transparency blending
+  GLState::SetBlend(true);
+  GLState::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+  m_VAO = std::make_unique<VertexArray>();
+  m_VertexBuffer = std::make_unique<VertexBuffer>(positions, 4 * 4 * sizeof(float));
+  VertexBufferLayout layout;
+  layout.Push<float>(2); // position
+  layout.Push<float>(2); // texture coordinates
+  m_VAO->AddBuffer(*m_VertexBuffer, layout);
+  m_IndexBuffer = std::make_unique<IndexBuffer>(indices, 6);
+
+  m_Shader = std::make_unique<Shader>("res/shaders/Basic.shader");
+  m_Shader->Bind();
+  m_Shader->SetUniform1i("u_Texture", 0);
+  m_MVPUniform = m_Shader->GetUniform<glm::mat4>("u_MVP");
+
+  TextureOptions options;
+  options.Mipmaps = true;
+
+  // The uncompressed reference, decoded and mipmapped at load time
+  auto start = std::chrono::high_resolution_clock::now();
+  Sample reference;
+  reference.Name = "RGBA8";
+  reference.Image = std::make_unique<Texture>("res/textures/bowser.png", options);
+  reference.UploadMs = MillisecondsSince(start);
+  int width = reference.Image->GetWidth(), height = reference.Image->GetHeight();
+  for (int level = 0; level < reference.Image->GetLevelCount(); level++)
+    reference.Bytes += (size_t)std::max(1, width >> level) * std::max(1, height >> level) * 4;
+  m_Samples.push_back(std::move(reference));
+
+  // The same image through each encoder. texture-baker does this offline and
+  // Texture loads the result from a .dds without any of the encode cost.
+  stbi_set_flip_vertically_on_load(1);
+  int bpp;
+  unsigned char *pixels = stbi_load("res/textures/bowser.png", &width, &height, &bpp, 4);
+  if (!pixels)
+    return;
+  std::vector<Mipmap::Level> chain = Mipmap::BuildChain(pixels, width, height);
+  const CompressedImage::BlockFormat formats[] = {CompressedImage::BlockFormat::BC1,
+                                                  CompressedImage::BlockFormat::BC3,
+                                                  CompressedImage::BlockFormat::BC7};
+  for (CompressedImage::BlockFormat format : formats) {
+    start = std::chrono::high_resolution_clock::now();
+    CompressedImage image;
+    image.Format = format;
+    image.Levels.push_back({width, height, BlockEncoder::Encode(pixels, width, height, format)});
+    for (const Mipmap::Level &level : chain) {
+      image.Levels.push_back({level.Width, level.Height,
+                              BlockEncoder::Encode(level.Pixels.data(), level.Width,
+                                                   level.Height, format)});
+    }
+    double encodeMs = MillisecondsSince(start);
+
+    start = std::chrono::high_resolution_clock::now();
+    Sample sample;
+    sample.Name = CompressedImage::GetFormatName(format);
+    sample.Image = std::make_unique<Texture>(image, options);
+    sample.UploadMs = MillisecondsSince(start);
+    sample.EncodeMs = encodeMs;
+    sample.Bytes = image.GetSize();
+    m_Samples.push_back(std::move(sample));
+  }
+  stbi_image_free(pixels);
+}
+
+TestCompressedTextures::~TestCompressedTextures() {}
+
+void TestCompressedTextures::OnRender() {
+  GLCall(glClearColor(0.3f, 0.3f, 0.3f, 1.0f));
+  GLCall(glClear(GL_COLOR_BUFFER_BIT));
+  Renderer renderer;
+
+  m_Shader->Bind();
+  for (size_t i = 0; i < m_Samples.size(); i++) {
+    float x = 960.0f * (i + 0.5f) / m_Samples.size();
+    glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(x, 270.0f, 0.0f));
+    model = glm::scale(model, glm::vec3(m_Zoom, m_Zoom, 1.0f));
+    m_Samples[i].Image->Bind();
+    m_Shader->SetUniform(m_MVPUniform, m_Proj * m_View * model);
+    renderer.Draw(*m_VAO, *m_IndexBuffer, *m_Shader);
+  }
+}
+
+void TestCompressedTextures::OnImGuiRender() {
+  ImGui::SliderFloat("Zoom", &m_Zoom, 0.1f, 4.0f);
+  ImGui::Columns(4);
+  ImGui::Text("Format");
+  ImGui::NextColumn();
+  ImGui::Text("VRAM");
+  ImGui::NextColumn();
+  ImGui::Text("Encode");
+  ImGui::NextColumn();
+  ImGui::Text("Load");
+  ImGui::NextColumn();
+  ImGui::Separator();
+  for (const Sample &sample : m_Samples) {
+    ImGui::Text("%s", sample.Name.c_str());
+    ImGui::NextColumn();
+    ImGui::Text("%.1f KB", sample.Bytes / 1024.0);
+    ImGui::NextColumn();
+    ImGui::Text("%.2f ms", sample.EncodeMs);
+    ImGui::NextColumn();
+    ImGui::Text("%.2f ms", sample.UploadMs);
+    ImGui::NextColumn();
+  }
+  ImGui::Columns(1);
+  ImGui::Text("Application average %.3f ms/frame (%.1f FPS)",
+              1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+}
+} // namespace test
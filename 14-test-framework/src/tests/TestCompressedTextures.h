@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Test.h"
+
+#include "VertexBuffer.h"
+#include "VertexBufferLayout.h"
+#include "Texture.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace test {
+    class TestCompressedTextures : public Test {
+        public:
+        TestCompressedTextures();
+        ~TestCompressedTextures();
+
+        void OnRender() override;
+        void OnImGuiRender() override;
+
+      private:
+        struct Sample {
+            std::string Name;
+            std::unique_ptr<Texture> Image;
+            size_t Bytes = 0; // Across every mip level
+            double EncodeMs = 0.0, UploadMs = 0.0;
+        };
+
+        std::unique_ptr<VertexArray> m_VAO;
+        std::unique_ptr<VertexBuffer> m_VertexBuffer;
+        std::unique_ptr<IndexBuffer> m_IndexBuffer;
+        std::unique_ptr<Shader> m_Shader;
+        Uniform<glm::mat4> m_MVPUniform;
+        std::vector<Sample> m_Samples;
+        glm::mat4 m_Proj, m_View;
+        float m_Zoom;
+    };
+    } // namespace test
@@ -0,0 +1,140 @@
+#include "TestGeometryArena.h"
+
+#include <cmath>
+#include <cstdlib>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "Renderer.h"
+#include "RenderStats.h"
+#include "TestHelpers.h"
+
+#include "imgui/imgui.h"
+
+namespace test {
+TestGeometryArena::TestGeometryArena()
+    : m_Proj(glm::ortho(0.0f, 960.0f, 0.0f, 540.0f, -1.0f, 1.0f)),
+      m_View(glm::mat4(1.0f)), m_TargetCount(2000), m_Churn(20),
+      m_AutoDefragment(true), m_DefragmentThreshold(0.5f), m_MultiDraw(false),
+      m_Defragments(0) {
+  // Alpha transparency blending
+  GLState::SetBlend(true);
+  GLState::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+  VertexBufferLayout layout;
+  layout.Push<float>(2);         // position
+  layout.Push<unsigned char>(4); // colour
+  // Deliberately small, so growing shows up as well as defragmenting
+  m_Arena = std::make_unique<GeometryArena>(layout, 16 * 1024, 32 * 1024);
+  m_Commands = std::make_unique<IndirectBuffer>(MaxMeshes);
+
+  m_Shader = std::make_unique<Shader>("res/shaders/VertexColor.shader");
+  m_ViewProjectionUniform = m_Shader->GetUniform<glm::mat4>("u_ViewProjection");
+
+  for (int i = 0; i < m_TargetCount; i++)
+    AddRandomMesh();
+}
+
+TestGeometryArena::~TestGeometryArena() {}
+
+void TestGeometryArena::AddRandomMesh() {
+  int sides = 3 + std::rand() % 30;
+  bool star = std::rand() % 2;
+  int ring = star ? sides * 2 : sides;
+  glm::vec2 center = {RandomFloat(0.0f, 960.0f), RandomFloat(0.0f, 540.0f)};
+  float radius = RandomFloat(4.0f, 14.0f);
+  unsigned char r = std::rand() % 192 + 64, g = std::rand() % 192 + 64,
+                b = std::rand() % 192 + 64;
+
+  m_Vertices.clear();
+  m_Indices.clear();
+  m_Vertices.push_back({center, {r, g, b, 255}});
+  for (int k = 0; k < ring; k++) {
+    float angle = 6.2831853f * k / ring;
+    float scale = star && (k & 1) ? radius * 0.5f : radius;
+    m_Vertices.push_back({center + glm::vec2(std::cos(angle), std::sin(angle)) * scale,
+                          {r, g, b, 160}});
+    m_Indices.push_back(0);
+    m_Indices.push_back(1 + k);
+    m_Indices.push_back(1 + (k + 1) % ring);
+  }
+  m_MeshIDs.push_back(m_Arena->Add(m_Vertices.data(), m_Vertices.size(),
+                                   m_Indices.data(), m_Indices.size()));
+}
+
+void TestGeometryArena::OnRender() {
+  GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+  GLCall(glClear(GL_COLOR_BUFFER_BIT));
+  Renderer renderer;
+
+  // Stream meshes out and in; their sizes differ, so holes build up
+  for (int i = 0; i < m_Churn && !m_MeshIDs.empty(); i++) {
+    int slot = std::rand() % m_MeshIDs.size();
+    m_Arena->Remove(m_MeshIDs[slot]);
+    m_MeshIDs[slot] = m_MeshIDs.back();
+    m_MeshIDs.pop_back();
+  }
+  while ((int)m_MeshIDs.size() > m_TargetCount) {
+    m_Arena->Remove(m_MeshIDs.back());
+    m_MeshIDs.pop_back();
+  }
+  while ((int)m_MeshIDs.size() < m_TargetCount)
+    AddRandomMesh();
+
+  if (m_AutoDefragment && m_Arena->GetFragmentation() > m_DefragmentThreshold) {
+    m_Arena->Defragment();
+    m_Defragments++;
+  }
+
+  m_Shader->Bind();
+  m_Shader->SetUniform(m_ViewProjectionUniform, m_Proj * m_View);
+  const VertexArray &va = m_Arena->GetVertexArray();
+  const IndexBuffer &ib = m_Arena->GetIndexBuffer();
+  if (m_MultiDraw) {
+    std::vector<DrawElementsIndirectCommand> commands;
+    commands.reserve(m_MeshIDs.size());
+    for (unsigned int id : m_MeshIDs) {
+      const GeometryArena::Mesh &mesh = m_Arena->GetMesh(id);
+      commands.push_back({mesh.IndexCount, 1, mesh.FirstIndex, mesh.BaseVertex, 0});
+    }
+    m_Commands->SetData(commands.data(), commands.size());
+    renderer.MultiDrawIndirect(va, ib, *m_Shader, *m_Commands);
+  } else {
+    // Same VAO and buffers for every mesh, so GLState skips all rebinds
+    for (unsigned int id : m_MeshIDs) {
+      const GeometryArena::Mesh &mesh = m_Arena->GetMesh(id);
+      renderer.Draw(va, ib, *m_Shader, mesh.IndexCount, mesh.BaseVertex, mesh.FirstIndex);
+    }
+  }
+}
+
+void TestGeometryArena::OnImGuiRender() {
+  ImGui::SliderInt("Meshes", &m_TargetCount, 1, MaxMeshes);
+  ImGui::SliderInt("Replaced per frame", &m_Churn, 0, 200);
+  ImGui::Checkbox("Multi-draw indirect", &m_MultiDraw);
+  ImGui::Checkbox("Auto defragment", &m_AutoDefragment);
+  if (m_AutoDefragment) {
+    ImGui::SliderFloat("Above fragmentation", &m_DefragmentThreshold, 0.05f, 0.95f);
+  }
+  if (ImGui::Button("Defragment now")) {
+    m_Arena->Defragment();
+    m_Defragments++;
+  }
+
+  const RangeAllocator &vertices = m_Arena->GetVertexRanges();
+  const RangeAllocator &indices = m_Arena->GetIndexRanges();
+  ImGui::Text("Vertices: %u of %u used, %u free ranges",
+              vertices.GetCapacity() - vertices.GetFree(), vertices.GetCapacity(),
+              vertices.GetFreeRangeCount());
+  ImGui::Text("Indices: %u of %u used, %u free ranges",
+              indices.GetCapacity() - indices.GetFree(), indices.GetCapacity(),
+              indices.GetFreeRangeCount());
+  ImGui::Text("Fragmentation: %.0f%%, defragmented %d times",
+              m_Arena->GetFragmentation() * 100.0f, m_Defragments);
+  const RenderStats &stats = RenderStats::GetLastFrame();
+  ImGui::Text("Draw calls: %u, VAO binds: %u", stats.DrawCalls, stats.VertexArrayBinds);
+  ImGui::Text("Application average %.3f ms/frame (%.1f FPS)",
+              1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+}
+} // namespace test
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Test.h"
+
+#include "GeometryArena.h"
+#include "IndirectBuffer.h"
+#include "Texture.h"
+
+#include <memory>
+#include <vector>
+
+namespace test {
+    class TestGeometryArena : public Test {
+        public:
+        TestGeometryArena();
+        ~TestGeometryArena();
+
+        void OnRender() override;
+        void OnImGuiRender() override;
+
+      private:
+        // Layout must match the attributes in VertexColor.shader
+        struct Vertex {
+            glm::vec2 Position;
+            unsigned char Color[4];
+        };
+
+        // Random polygon or star somewhere on screen, baked into world space
+        void AddRandomMesh();
+
+        static const int MaxMeshes = 10000;
+
+        std::unique_ptr<GeometryArena> m_Arena;
+        std::unique_ptr<IndirectBuffer> m_Commands;
+        std::unique_ptr<Shader> m_Shader;
+        Uniform<glm::mat4> m_ViewProjectionUniform;
+        std::vector<unsigned int> m_MeshIDs;
+        std::vector<Vertex> m_Vertices;        // Scratch for AddRandomMesh
+        std::vector<unsigned int> m_Indices;
+        glm::mat4 m_Proj, m_View;
+        int m_TargetCount;
+        int m_Churn; // Meshes replaced per frame
+        bool m_AutoDefragment;
+        float m_DefragmentThreshold;
+        bool m_MultiDraw;
+        int m_Defragments;
+    };
+    } // namespace test
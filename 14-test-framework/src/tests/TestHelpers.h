@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdlib>
+
+#include <glm/glm.hpp>
+
+// Shared by the scenes that bounce many objects around the 960x540 window
+namespace test {
+inline float RandomFloat(float min, float max) {
+  return min + (max - min) * ((float)std::rand() / (float)RAND_MAX);
+}
+
+// Moves position by velocity (pixels per 1/60 s) over step seconds, first
+// reversing velocity on each axis where position has reached an edge
+inline void Bounce(glm::vec2 &position, glm::vec2 &velocity, float step) {
+  if (position.x >= 960 || position.x <= 0)
+    velocity.x *= -1;
+  if (position.y >= 540 || position.y <= 0)
+    velocity.y *= -1;
+  position += velocity * (step * 60.0f);
+}
+} // namespace test
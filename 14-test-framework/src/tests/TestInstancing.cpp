@@ -0,0 +1,124 @@
+#include "TestInstancing.h"
+
+#include <cstdlib>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "Renderer.h"
+#include "TestHelpers.h"
+
+#include "imgui/imgui.h"
+
+namespace test {
+TestInstancing::TestInstancing()
+    : m_Proj(glm::ortho(0.0f, 960.0f, 0.0f, 540.0f, -1.0f, 1.0f)),
+      m_View(glm::mat4(1.0f)), m_InstanceCount(0), m_Scale(0.2f),
+      m_RenderScale(0.2f) {
+  // The same unit quad as TestTexture2D; it is uploaded once and drawn once
+  // per frame no matter how many copies are on screen
+  float positions[] = {
+      -50.0f, -50.0f, 0.0f, 0.0f, // bottom left
+       50.0f, -50.0f, 1.0f, 0.0f, // bottom right
+       50.0f,  50.0f, 1.0f, 1.0f, // top right
+      -50.0f,  50.0f, 0.0f, 1.0f  // top left
+  };
+  unsigned int indices[] = {0, 1, 2, 2, 3, 0};
+
+  // Alpha transparency blending
+  GLState::SetBlend(true);
+  GLState::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+  m_VAO = std::make_unique<VertexArray>();
+  m_VertexBuffer = std::make_unique<VertexBuffer>(positions, 4 * 4 * sizeof(float));
+  VertexBufferLayout layout;
+  layout.Push<float>(2); // position
+  layout.Push<float>(2); // texture coordinates
+  m_VAO->AddBuffer(*m_VertexBuffer, layout);
+
+  m_InstanceBuffer = std::make_unique<VertexBuffer>(MaxInstances * sizeof(InstanceData));
+  VertexBufferLayout instanceLayout;
+  instanceLayout.Push<float>(4, 1); // model matrix, one column per location
+  instanceLayout.Push<float>(4, 1);
+  instanceLayout.Push<float>(4, 1);
+  instanceLayout.Push<float>(4, 1);
+  instanceLayout.Push<float>(4, 1); // texture rectangle
+  instanceLayout.Push<float>(4, 1); // tint
+  m_VAO->AddBuffer(*m_InstanceBuffer, instanceLayout);
+
+  m_IndexBuffer = std::make_unique<IndexBuffer>(indices, 6);
+
+  m_Shader = std::make_unique<Shader>("res/shaders/Instanced.shader");
+  m_Shader->Bind();
+  m_Texture = std::make_unique<Texture>("res/textures/bowser.png");
+  m_Shader->SetUniform1i("u_Texture", 0);
+  m_ViewProjectionUniform = m_Shader->GetUniform<glm::mat4>("u_ViewProjection");
+
+  m_RenderSprites.reserve(MaxInstances);
+  m_Instances.reserve(MaxInstances);
+  Resize(5000);
+}
+
+TestInstancing::~TestInstancing() {}
+
+void TestInstancing::Resize(int count) {
+  int oldCount = m_InstanceCount;
+  m_Sprites.resize(count);
+  for (int i = oldCount; i < count; i++) {
+    Sprite &sprite = m_Sprites[i];
+    sprite.Position = {RandomFloat(0.0f, 960.0f), RandomFloat(0.0f, 540.0f)};
+    sprite.Velocity = {RandomFloat(-2.0f, 2.0f), RandomFloat(-2.0f, 2.0f)};
+    sprite.Rotation = RandomFloat(0.0f, 6.283f);
+    sprite.Spin = RandomFloat(-0.05f, 0.05f);
+  }
+  m_InstanceCount = count;
+}
+
+void TestInstancing::OnFixedUpdate(float step) {
+  float scale = step * 60.0f;
+  for (Sprite &sprite : m_Sprites) {
+    Bounce(sprite.Position, sprite.Velocity, step);
+    sprite.Rotation += sprite.Spin * scale;
+  }
+}
+
+void TestInstancing::OnSnapshot() {
+  // Reuses the capacity reserved up front, so this is a plain copy
+  m_RenderSprites = m_Sprites;
+  m_RenderScale = m_Scale;
+}
+
+void TestInstancing::OnRender() {
+  GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+  GLCall(glClear(GL_COLOR_BUFFER_BIT));
+  Renderer renderer;
+
+  // Build the per-instance stream; this replaces a uniform upload and a draw
+  // call per sprite
+  m_Instances.clear();
+  for (const Sprite &sprite : m_RenderSprites) {
+    glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(sprite.Position, 0.0f));
+    model = glm::rotate(model, sprite.Rotation, glm::vec3(0.0f, 0.0f, 1.0f));
+    model = glm::scale(model, glm::vec3(m_RenderScale, m_RenderScale, 1.0f));
+    m_Instances.push_back({model, glm::vec4(0.0f, 0.0f, 1.0f, 1.0f),
+                           glm::vec4(1.0f)});
+  }
+  m_InstanceBuffer->SetData(m_Instances.data(), m_Instances.size() * sizeof(InstanceData));
+
+  m_Texture->Bind();
+  m_Shader->Bind();
+  m_Shader->SetUniform(m_ViewProjectionUniform, m_Proj * m_View);
+  renderer.DrawInstanced(*m_VAO, *m_IndexBuffer, *m_Shader, m_Instances.size());
+}
+
+void TestInstancing::OnImGuiRender() {
+  int count = m_InstanceCount;
+  if (ImGui::SliderInt("Instances", &count, 1, MaxInstances)) {
+    Resize(count);
+  }
+  ImGui::SliderFloat("Scale", &m_Scale, 0.05f, 2.0f);
+  ImGui::Text("Draw calls: 1");
+  ImGui::Text("Application average %.3f ms/frame (%.1f FPS)",
+              1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+}
+} // namespace test
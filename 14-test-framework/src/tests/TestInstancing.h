@@ -0,0 +1,62 @@
+#pragma once
+
+#include "Test.h"
+
+#include "VertexBuffer.h"
+#include "VertexBufferLayout.h"
+#include "Texture.h"
+
+#include <memory>
+#include <vector>
+
+namespace test {
+    class TestInstancing : public Test {
+        public:
+        TestInstancing();
+        ~TestInstancing();
+
+        void OnFixedUpdate(float step) override;
+        void OnRender() override;
+        void OnImGuiRender() override;
+
+        bool IsPipelined() const override { return true; }
+        void OnSnapshot() override;
+
+      private:
+        // Layout must match the per-instance attributes in Instanced.shader
+        struct InstanceData {
+            glm::mat4 Model;
+            glm::vec4 TexRect;
+            glm::vec4 Tint;
+        };
+
+        struct Sprite {
+            glm::vec2 Position;
+            glm::vec2 Velocity; // pixels per 1/60 s
+            float Rotation, Spin; // radians, radians per 1/60 s
+        };
+
+        void Resize(int count);
+
+        static const int MaxInstances = 100000;
+
+        std::unique_ptr<VertexArray> m_VAO;
+        std::unique_ptr<VertexBuffer> m_VertexBuffer;
+        std::unique_ptr<VertexBuffer> m_InstanceBuffer;
+        std::unique_ptr<IndexBuffer> m_IndexBuffer;
+        std::unique_ptr<Shader> m_Shader;
+        std::unique_ptr<Texture> m_Texture;
+        Uniform<glm::mat4> m_ViewProjectionUniform;
+        glm::mat4 m_Proj, m_View;
+
+        // Simulation and UI side
+        std::vector<Sprite> m_Sprites;
+        int m_InstanceCount;
+        float m_Scale;
+
+        // Render side, copied from the above in OnSnapshot
+        std::vector<Sprite> m_RenderSprites;
+        float m_RenderScale;
+        std::vector<InstanceData> m_Instances;
+    };
+    } // namespace test
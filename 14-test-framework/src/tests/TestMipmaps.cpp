@@ -0,0 +1,125 @@
+#include "TestMipmaps.h"
+
+#include <chrono>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "Renderer.h"
+
+#include "imgui/imgui.h"
+
+namespace test {
+TestMipmaps::TestMipmaps()
+    : m_Proj(glm::perspective(glm::radians(60.0f), 960.0f / 540.0f, 0.1f, 1000.0f)),
+      m_Mode(Gpu), m_Trilinear(true), m_Anisotropy(1.0f), m_Tilt(80.0f),
+      m_Scroll(0.0f), m_PrevScroll(0.0f), m_Speed(0.01f), m_BuildMs(0.0) {
+  // A large ground plane with the checker tiled across it. Far away each
+  // pixel covers many texels, which is where missing mipmaps shimmer.
+  const float repeats = 64.0f;
+  float positions[] = {
+      -100.0f, -100.0f, 0.0f,    0.0f,    // bottom left
+       100.0f, -100.0f, repeats, 0.0f,    // bottom right
+       100.0f,  100.0f, repeats, repeats, // top right
+      -100.0f,  100.0f, 0.0f,    repeats  // top left
+  };
+  unsigned int indices[] = {0, 1, 2, 2, 3, 0};
+
+  GLState::SetBlend(false);
+
+  m_VAO = std::make_unique<VertexArray>();
+  m_VertexBuffer = std::make_unique<VertexBuffer>(positions, 4 * 4 * sizeof(float));
+  VertexBufferLayout layout;
+  layout.Push<float>(2); // position
+  layout.Push<float>(2); // texture coordinates
+  m_VAO->AddBuffer(*m_VertexBuffer, layout);
+  m_IndexBuffer = std::make_unique<IndexBuffer>(indices, 6);
+
+  m_Shader = std::make_unique<Shader>("res/shaders/Basic.shader");
+  m_Shader->Bind();
+  m_Shader->SetUniform1i("u_Texture", 0);
+  m_MVPUniform = m_Shader->GetUniform<glm::mat4>("u_MVP");
+
+  // Black and white squares with thin red lines: high contrast at every scale
+  m_Checker.resize(CheckerSize * CheckerSize * 4);
+  for (int y = 0; y < CheckerSize; y++) {
+    for (int x = 0; x < CheckerSize; x++) {
+      unsigned char *pixel = &m_Checker[(y * CheckerSize + x) * 4];
+      bool white = ((x / 32) + (y / 32)) % 2 == 0;
+      bool line = x % 64 == 0 || y % 64 == 0;
+      pixel[0] = line ? 255 : (white ? 255 : 0);
+      pixel[1] = line ? 0 : (white ? 255 : 0);
+      pixel[2] = line ? 0 : (white ? 255 : 0);
+      pixel[3] = 255;
+    }
+  }
+  CreateTexture();
+}
+
+TestMipmaps::~TestMipmaps() {}
+
+void TestMipmaps::CreateTexture() {
+  TextureOptions options;
+  options.Repeat = true;
+  options.Mipmaps = m_Mode != None;
+  options.CpuMipmaps = m_Mode == CpuBox || m_Mode == CpuKaiser;
+  options.MipFilter = m_Mode == CpuKaiser ? Mipmap::Filter::Kaiser : Mipmap::Filter::Box;
+  options.Trilinear = m_Trilinear;
+  options.Anisotropy = m_Anisotropy;
+
+  auto start = std::chrono::high_resolution_clock::now();
+  m_Texture = std::make_unique<Texture>(CheckerSize, CheckerSize, m_Checker.data(), options);
+  auto end = std::chrono::high_resolution_clock::now();
+  m_BuildMs = std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+void TestMipmaps::OnFixedUpdate(float step) {
+  float scale = step * 60.0f;
+  m_PrevScroll = m_Scroll;
+  m_Scroll += m_Speed * scale;
+}
+
+void TestMipmaps::OnRender() {
+  GLCall(glClearColor(0.2f, 0.3f, 0.4f, 1.0f));
+  GLCall(glClear(GL_COLOR_BUFFER_BIT));
+  Renderer renderer;
+
+  // Scrolling moves the plane by whole checker repeats so it loops seamlessly
+  float scroll = m_PrevScroll + (m_Scroll - m_PrevScroll) * m_Interpolation;
+  float repeat = 200.0f / 64.0f;
+  scroll = (scroll - (int)scroll) * repeat;
+
+  glm::mat4 view = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, -2.0f, -5.0f));
+  glm::mat4 model = glm::rotate(glm::mat4(1.0f), glm::radians(-m_Tilt),
+                                glm::vec3(1.0f, 0.0f, 0.0f));
+  model = glm::translate(model, glm::vec3(0.0f, -scroll, 0.0f));
+
+  m_Texture->Bind();
+  m_Shader->Bind();
+  m_Shader->SetUniform(m_MVPUniform, m_Proj * view * model);
+  renderer.Draw(*m_VAO, *m_IndexBuffer, *m_Shader);
+}
+
+void TestMipmaps::OnImGuiRender() {
+  const char *modes[] = {"None", "glGenerateMipmap", "CPU box", "CPU Kaiser"};
+  if (ImGui::Combo("Mipmaps", &m_Mode, modes, 4)) {
+    CreateTexture();
+  }
+  // Sampling changes are texture parameters, no need to rebuild the chain
+  bool sampling = ImGui::Checkbox("Trilinear", &m_Trilinear);
+  float maxAnisotropy = Texture::GetMaxAnisotropy();
+  if (maxAnisotropy > 1.0f) {
+    sampling |= ImGui::SliderFloat("Anisotropy", &m_Anisotropy, 1.0f, maxAnisotropy);
+  } else {
+    ImGui::Text("Anisotropic filtering not supported");
+  }
+  if (sampling) {
+    m_Texture->SetSampling(m_Trilinear, m_Anisotropy);
+  }
+  ImGui::SliderFloat("Tilt", &m_Tilt, 0.0f, 89.0f);
+  ImGui::SliderFloat("Speed", &m_Speed, 0.0f, 0.05f);
+  ImGui::Text("Levels: %d, built in %.3f ms", m_Texture->GetLevelCount(), m_BuildMs);
+  ImGui::Text("Application average %.3f ms/frame (%.1f FPS)",
+              1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+}
+} // namespace test
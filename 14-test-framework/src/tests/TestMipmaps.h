@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Test.h"
+
+#include "VertexBuffer.h"
+#include "VertexBufferLayout.h"
+#include "Texture.h"
+
+#include <memory>
+#include <vector>
+
+namespace test {
+    class TestMipmaps : public Test {
+        public:
+        TestMipmaps();
+        ~TestMipmaps();
+
+        void OnFixedUpdate(float step) override;
+        void OnRender() override;
+        void OnImGuiRender() override;
+
+      private:
+        enum Mode { None, Gpu, CpuBox, CpuKaiser };
+
+        // Rebuilds m_Texture for the current mode and sampling settings
+        void CreateTexture();
+
+        static const int CheckerSize = 256;
+
+        std::unique_ptr<VertexArray> m_VAO;
+        std::unique_ptr<VertexBuffer> m_VertexBuffer;
+        std::unique_ptr<IndexBuffer> m_IndexBuffer;
+        std::unique_ptr<Shader> m_Shader;
+        std::unique_ptr<Texture> m_Texture;
+        Uniform<glm::mat4> m_MVPUniform;
+        std::vector<unsigned char> m_Checker;
+        glm::mat4 m_Proj;
+        int m_Mode;
+        bool m_Trilinear;
+        float m_Anisotropy;
+        float m_Tilt; // degrees the ground plane leans away from the camera
+        float m_Scroll, m_PrevScroll; // texture repeats scrolled towards the camera
+        float m_Speed; // repeats per 1/60 s
+        double m_BuildMs;
+    };
+    } // namespace test
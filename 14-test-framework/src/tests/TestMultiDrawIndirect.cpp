@@ -0,0 +1,150 @@
+#include "TestMultiDrawIndirect.h"
+
+#include <cmath>
+#include <cstdlib>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "GPUProfiler.h"
+#include "Renderer.h"
+#include "RenderStats.h"
+#include "TestHelpers.h"
+
+#include "imgui/imgui.h"
+
+namespace test {
+TestMultiDrawIndirect::TestMultiDrawIndirect()
+    : m_Proj(glm::ortho(0.0f, 960.0f, 0.0f, 540.0f, -1.0f, 1.0f)),
+      m_View(glm::mat4(1.0f)), m_CommandsDirty(true), m_PerMeshCalls(false) {
+  // Distinct meshes packed into one vertex and one index buffer: polygons
+  // with 3 to 14 sides, then the same as stars with a shrinking inner radius.
+  // Indices are local to each mesh; the draw command's BaseVertex places them.
+  std::vector<float> vertices;
+  std::vector<unsigned int> indices;
+  for (int i = 0; i < MeshCount; i++) {
+    int sides = 3 + i % 12;
+    bool star = i >= 12;
+    float inner = 1.0f - 0.2f * (i / 12);
+    int ring = star ? sides * 2 : sides;
+
+    m_Meshes.push_back({(unsigned int)indices.size(), (unsigned int)ring * 3,
+                        (int)vertices.size() / 2});
+    vertices.push_back(0.0f);
+    vertices.push_back(0.0f);
+    for (int k = 0; k < ring; k++) {
+      float angle = 6.2831853f * k / ring;
+      float radius = star && (k & 1) ? inner : 1.0f;
+      vertices.push_back(std::cos(angle) * radius);
+      vertices.push_back(std::sin(angle) * radius);
+      indices.push_back(0);
+      indices.push_back(1 + k);
+      indices.push_back(1 + (k + 1) % ring);
+    }
+  }
+
+  // Alpha transparency blending
+  GLState::SetBlend(true);
+  GLState::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+  m_VAO = std::make_unique<VertexArray>();
+  m_VertexBuffer = std::make_unique<VertexBuffer>(vertices.data(), vertices.size() * sizeof(float));
+  VertexBufferLayout layout;
+  layout.Push<float>(2); // position
+  m_VAO->AddBuffer(*m_VertexBuffer, layout);
+
+  m_InstanceBuffer = std::make_unique<VertexBuffer>(MaxObjects * sizeof(InstanceData));
+  VertexBufferLayout instanceLayout;
+  instanceLayout.Push<float>(4, 1); // offset, rotation, scale
+  instanceLayout.Push<float>(4, 1); // tint
+  m_VAO->AddBuffer(*m_InstanceBuffer, instanceLayout);
+
+  m_IndexBuffer = std::make_unique<IndexBuffer>(indices.data(), indices.size());
+  m_Commands = std::make_unique<IndirectBuffer>(MaxObjects);
+
+  m_Shader = std::make_unique<Shader>("res/shaders/MultiDraw.shader");
+  m_ViewProjectionUniform = m_Shader->GetUniform<glm::mat4>("u_ViewProjection");
+
+  m_Instances.reserve(MaxObjects);
+  Resize(5000);
+}
+
+TestMultiDrawIndirect::~TestMultiDrawIndirect() {}
+
+void TestMultiDrawIndirect::Resize(int count) {
+  int oldCount = m_Objects.size();
+  m_Objects.resize(count);
+  for (int i = oldCount; i < count; i++) {
+    Object &object = m_Objects[i];
+    object.Position = {RandomFloat(0.0f, 960.0f), RandomFloat(0.0f, 540.0f)};
+    object.Velocity = {RandomFloat(-1.5f, 1.5f), RandomFloat(-1.5f, 1.5f)};
+    object.Rotation = RandomFloat(0.0f, 6.283f);
+    object.Spin = RandomFloat(-0.05f, 0.05f);
+    object.Scale = RandomFloat(4.0f, 12.0f);
+    object.Tint = {RandomFloat(0.3f, 1.0f), RandomFloat(0.3f, 1.0f),
+                   RandomFloat(0.3f, 1.0f), 0.8f};
+    object.MeshIndex = std::rand() % MeshCount;
+  }
+  m_CommandsDirty = true;
+}
+
+void TestMultiDrawIndirect::OnFixedUpdate(float step) {
+  float scale = step * 60.0f;
+  for (Object &object : m_Objects) {
+    Bounce(object.Position, object.Velocity, step);
+    object.Rotation += object.Spin * scale;
+  }
+}
+
+void TestMultiDrawIndirect::OnRender() {
+  GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+  GLCall(glClear(GL_COLOR_BUFFER_BIT));
+  Renderer renderer;
+
+  // One command per object; its BaseInstance is the object's slot in the
+  // instance stream. They only change with the object count.
+  if (m_CommandsDirty) {
+    std::vector<DrawElementsIndirectCommand> commands;
+    commands.reserve(m_Objects.size());
+    for (unsigned int i = 0; i < m_Objects.size(); i++) {
+      const Mesh &mesh = m_Meshes[m_Objects[i].MeshIndex];
+      commands.push_back({mesh.IndexCount, 1, mesh.FirstIndex, mesh.BaseVertex, i});
+    }
+    m_Commands->SetData(commands.data(), commands.size());
+    m_CommandsDirty = false;
+  }
+
+  m_Instances.clear();
+  for (const Object &object : m_Objects) {
+    m_Instances.push_back({glm::vec4(object.Position, object.Rotation, object.Scale),
+                           object.Tint});
+  }
+  m_InstanceBuffer->SetData(m_Instances.data(), m_Instances.size() * sizeof(InstanceData));
+
+  m_Shader->Bind();
+  m_Shader->SetUniform(m_ViewProjectionUniform, m_Proj * m_View);
+  // One GPU scope for the pass, so both modes are timed the same way
+  GPU_PROFILE_SCOPE("Objects");
+  if (m_PerMeshCalls) {
+    // Same commands, one API call each, to compare against
+    for (unsigned int i = 0; i < m_Commands->GetCount(); i++)
+      renderer.MultiDrawIndirect(*m_VAO, *m_IndexBuffer, *m_Shader, *m_Commands, i, 1);
+  } else {
+    renderer.MultiDrawIndirect(*m_VAO, *m_IndexBuffer, *m_Shader, *m_Commands);
+  }
+}
+
+void TestMultiDrawIndirect::OnImGuiRender() {
+  int count = (int)m_Objects.size();
+  if (ImGui::SliderInt("Objects", &count, 1, MaxObjects)) {
+    Resize(count);
+  }
+  ImGui::Checkbox("One call per object", &m_PerMeshCalls);
+  if (!IndirectBuffer::IsSupported()) {
+    ImGui::Text("Multi-draw indirect not supported, issuing one call per command");
+  }
+  ImGui::Text("Meshes: %d, draw calls: %u", MeshCount, RenderStats::GetLastFrame().DrawCalls);
+  ImGui::Text("Application average %.3f ms/frame (%.1f FPS)",
+              1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+}
+} // namespace test
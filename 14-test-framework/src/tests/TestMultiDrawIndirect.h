@@ -0,0 +1,64 @@
+#pragma once
+
+#include "Test.h"
+
+#include "IndirectBuffer.h"
+#include "VertexBuffer.h"
+#include "VertexBufferLayout.h"
+#include "Texture.h"
+
+#include <memory>
+#include <vector>
+
+namespace test {
+    class TestMultiDrawIndirect : public Test {
+        public:
+        TestMultiDrawIndirect();
+        ~TestMultiDrawIndirect();
+
+        void OnFixedUpdate(float step) override;
+        void OnRender() override;
+        void OnImGuiRender() override;
+
+      private:
+        // Layout must match the per-instance attributes in MultiDraw.shader
+        struct InstanceData {
+            glm::vec4 Transform; // offset, rotation, scale
+            glm::vec4 Tint;
+        };
+
+        // Range of the shared vertex and index buffers
+        struct Mesh {
+            unsigned int FirstIndex, IndexCount;
+            int BaseVertex;
+        };
+
+        struct Object {
+            glm::vec2 Position;
+            glm::vec2 Velocity; // pixels per 1/60 s
+            float Rotation, Spin; // radians, radians per 1/60 s
+            float Scale;
+            glm::vec4 Tint;
+            int MeshIndex;
+        };
+
+        void Resize(int count);
+
+        static const int MeshCount = 48;
+        static const int MaxObjects = 20000;
+
+        std::unique_ptr<VertexArray> m_VAO;
+        std::unique_ptr<VertexBuffer> m_VertexBuffer;
+        std::unique_ptr<VertexBuffer> m_InstanceBuffer;
+        std::unique_ptr<IndexBuffer> m_IndexBuffer;
+        std::unique_ptr<IndirectBuffer> m_Commands;
+        std::unique_ptr<Shader> m_Shader;
+        Uniform<glm::mat4> m_ViewProjectionUniform;
+        std::vector<Mesh> m_Meshes;
+        std::vector<Object> m_Objects;
+        std::vector<InstanceData> m_Instances;
+        glm::mat4 m_Proj, m_View;
+        bool m_CommandsDirty; // Object count changed since the last upload
+        bool m_PerMeshCalls;
+    };
+    } // namespace test
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Test.h"
+
+#include "CommandBuffer.h"
+#include "ThreadPool.h"
+#include "VertexBuffer.h"
+#include "VertexBufferLayout.h"
+#include "Texture.h"
+
+#include <memory>
+#include <vector>
+
+namespace test {
+    class TestParallelCommands : public Test {
+        public:
+        TestParallelCommands();
+        ~TestParallelCommands();
+
+        void OnFixedUpdate(float step) override;
+        void OnRender() override;
+        void OnImGuiRender() override;
+
+      private:
+        struct Sprite {
+            glm::vec2 Position, PrevPosition;
+            glm::vec2 Velocity; // pixels per 1/60 s
+            float Rotation, Spin; // radians, radians per 1/60 s
+        };
+
+        void Resize(int count);
+        // Records sprites [begin, end) into buffer; runs on any thread
+        void Record(CommandBuffer &buffer, int begin, int end) const;
+
+        static const int MaxSprites = 50000;
+
+        std::unique_ptr<VertexArray> m_VAO;
+        std::unique_ptr<VertexBuffer> m_VertexBuffer;
+        std::unique_ptr<IndexBuffer> m_IndexBuffer;
+        std::unique_ptr<Shader> m_Shader;
+        std::unique_ptr<Texture> m_Texture;
+        Uniform<glm::mat4> m_MVPUniform;
+        std::vector<Sprite> m_Sprites;
+        std::vector<CommandBuffer> m_Buffers; // One per partition
+        glm::mat4 m_Proj, m_View;
+        int m_Partitions;
+        double m_RecordMs, m_ExecuteMs;
+        // Declared last so the workers stop before the buffers go away
+        std::unique_ptr<ThreadPool> m_Pool;
+    };
+    } // namespace test
@@ -0,0 +1,125 @@
+#include "TestRenderQueue.h"
+
+#include <cstdlib>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "Renderer.h"
+#include "RenderStats.h"
+#include "TestHelpers.h"
+
+#include "imgui/imgui.h"
+
+namespace test {
+TestRenderQueue::TestRenderQueue()
+    : m_Proj(glm::ortho(0.0f, 960.0f, 0.0f, 540.0f, -1.0f, 1.0f)),
+      m_View(glm::mat4(1.0f)), m_Sort(true), m_TranslucentShare(0.2f) {
+  float positions[] = {
+      -10.0f, -10.0f, 0.0f, 0.0f, // bottom left
+       10.0f, -10.0f, 1.0f, 0.0f, // bottom right
+       10.0f,  10.0f, 1.0f, 1.0f, // top right
+      -10.0f,  10.0f, 0.0f, 1.0f  // top left
+  };
+  unsigned int indices[] = {0, 1, 2, 2, 3, 0};
+
+  // Alpha transparency blending
+  GLState::SetBlend(true);
+  GLState::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+  m_VAO = std::make_unique<VertexArray>();
+  m_VertexBuffer = std::make_unique<VertexBuffer>(positions, 4 * 4 * sizeof(float));
+  VertexBufferLayout layout;
+  layout.Push<float>(2); // position
+  layout.Push<float>(2); // texture coordinates
+  m_VAO->AddBuffer(*m_VertexBuffer, layout);
+  m_IndexBuffer = std::make_unique<IndexBuffer>(indices, 6);
+
+  const char *shaders[] = {"res/shaders/Basic.shader", "res/shaders/Tinted.shader"};
+  for (int i = 0; i < 2; i++) {
+    m_Shaders[i] = std::make_unique<Shader>(shaders[i]);
+    m_Shaders[i]->Bind();
+    m_Shaders[i]->SetUniform1i("u_Texture", 0);
+    m_MVPUniforms[i] = m_Shaders[i]->GetUniform<glm::mat4>("u_MVP");
+  }
+  m_ColorUniform = m_Shaders[1]->GetUniform<glm::vec4>("u_Color");
+
+  // Bowser plus a few flat colours, so there is texture state to sort by
+  m_Textures.push_back(std::make_unique<Texture>("res/textures/bowser.png"));
+  for (int i = 0; i < 7; i++) {
+    unsigned char pixel[4] = {(unsigned char)(i & 1 ? 255 : 64),
+                              (unsigned char)(i & 2 ? 255 : 64),
+                              (unsigned char)(i & 4 ? 255 : 64), 255};
+    m_Textures.push_back(std::make_unique<Texture>(1, 1, pixel));
+  }
+
+  Resize(5000);
+}
+
+TestRenderQueue::~TestRenderQueue() {}
+
+void TestRenderQueue::Resize(int count) {
+  int oldCount = (int)m_Sprites.size();
+  m_Sprites.resize(count);
+  for (int i = oldCount; i < count; i++) {
+    Sprite &sprite = m_Sprites[i];
+    sprite.Position = {RandomFloat(0.0f, 960.0f), RandomFloat(0.0f, 540.0f)};
+    sprite.PrevPosition = sprite.Position;
+    sprite.Velocity = {RandomFloat(-2.0f, 2.0f), RandomFloat(-2.0f, 2.0f)};
+    sprite.Depth = RandomFloat(0.0f, 1.0f);
+    sprite.ShaderIndex = std::rand() % 2;
+    sprite.TextureIndex = std::rand() % (int)m_Textures.size();
+    sprite.Translucent = RandomFloat(0.0f, 1.0f) < m_TranslucentShare;
+  }
+}
+
+void TestRenderQueue::OnFixedUpdate(float step) {
+  for (Sprite &sprite : m_Sprites) {
+    sprite.PrevPosition = sprite.Position;
+    Bounce(sprite.Position, sprite.Velocity, step);
+  }
+}
+
+void TestRenderQueue::OnRender() {
+  GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+  GLCall(glClear(GL_COLOR_BUFFER_BIT));
+  Renderer renderer;
+
+  // Submitted in random state order; the queue regroups them
+  glm::mat4 viewProjection = m_Proj * m_View;
+  for (const Sprite &sprite : m_Sprites) {
+    glm::vec2 position = glm::mix(sprite.PrevPosition, sprite.Position, m_Interpolation);
+    glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(position, 0.0f));
+
+    DrawItem item;
+    item.Program = m_Shaders[sprite.ShaderIndex].get();
+    item.VAO = m_VAO.get();
+    item.IBO = m_IndexBuffer.get();
+    item.Tex = m_Textures[sprite.TextureIndex].get();
+    m_Queue.Submit(item, 0, sprite.Translucent, sprite.Depth);
+    m_Queue.SetUniform(m_MVPUniforms[sprite.ShaderIndex], viewProjection * model);
+    if (sprite.ShaderIndex == 1) {
+      m_Queue.SetUniform(m_ColorUniform,
+                         glm::vec4(1.0f, 1.0f, 1.0f, sprite.Translucent ? 0.5f : 1.0f));
+    }
+  }
+  m_Queue.Flush(renderer, m_Sort);
+}
+
+void TestRenderQueue::OnImGuiRender() {
+  int count = (int)m_Sprites.size();
+  if (ImGui::SliderInt("Sprites", &count, 1, MaxSprites)) {
+    Resize(count);
+  }
+  if (ImGui::SliderFloat("Translucent share", &m_TranslucentShare, 0.0f, 1.0f)) {
+    for (Sprite &sprite : m_Sprites)
+      sprite.Translucent = RandomFloat(0.0f, 1.0f) < m_TranslucentShare;
+  }
+  ImGui::Checkbox("Sort by key", &m_Sort);
+  const RenderStats &stats = RenderStats::GetLastFrame();
+  ImGui::Text("Program binds: %u, texture binds: %u", stats.ProgramBinds,
+              stats.TextureBinds);
+  ImGui::Text("Application average %.3f ms/frame (%.1f FPS)",
+              1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+}
+} // namespace test
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Test.h"
+
+#include "RenderQueue.h"
+#include "VertexBuffer.h"
+#include "VertexBufferLayout.h"
+#include "Texture.h"
+
+#include <memory>
+#include <vector>
+
+namespace test {
+    class TestRenderQueue : public Test {
+        public:
+        TestRenderQueue();
+        ~TestRenderQueue();
+
+        void OnFixedUpdate(float step) override;
+        void OnRender() override;
+        void OnImGuiRender() override;
+
+      private:
+        struct Sprite {
+            glm::vec2 Position, PrevPosition;
+            glm::vec2 Velocity; // pixels per 1/60 s
+            float Depth;
+            int ShaderIndex, TextureIndex;
+            bool Translucent;
+        };
+
+        void Resize(int count);
+
+        static const int MaxSprites = 20000;
+
+        std::unique_ptr<VertexArray> m_VAO;
+        std::unique_ptr<VertexBuffer> m_VertexBuffer;
+        std::unique_ptr<IndexBuffer> m_IndexBuffer;
+        std::unique_ptr<Shader> m_Shaders[2];
+        Uniform<glm::mat4> m_MVPUniforms[2];
+        Uniform<glm::vec4> m_ColorUniform; // Tinted.shader only
+        std::vector<std::unique_ptr<Texture>> m_Textures;
+        std::vector<Sprite> m_Sprites;
+        RenderQueue m_Queue;
+        glm::mat4 m_Proj, m_View;
+        bool m_Sort;
+        float m_TranslucentShare;
+    };
+    } // namespace test
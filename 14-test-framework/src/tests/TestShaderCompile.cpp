@@ -0,0 +1,107 @@
+#include "TestShaderCompile.h"
+
+#include <algorithm>
+
+#include "Renderer.h"
+
+#include "imgui/imgui.h"
+
+namespace test {
+static float MillisecondsSince(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Insert a define after the #version line, which must stay first
+static std::string AddDefine(const std::string &source, const std::string &define) {
+  size_t end = source.find('\n');
+  if (end == std::string::npos) {
+    return source;
+  }
+  return source.substr(0, end + 1) + define + "\n" + source.substr(end + 1);
+}
+
+TestShaderCompile::TestShaderCompile()
+    : m_Source(Shader::ParseShader("res/shaders/Basic.shader")),
+      m_Compiler(std::make_unique<ShaderCompiler>()), m_ProgramCount(16),
+      m_Run(0), m_SerialMs(0.0f), m_BatchPending(false),
+      m_BatchSubmitMs(0.0f), m_BatchTotalMs(0.0f), m_BatchLongestPollMs(0.0f),
+      m_BatchFrames(0) {}
+
+TestShaderCompile::~TestShaderCompile() {
+  // Pending shaders are deleted mid-compile; the driver discards the work
+  m_Shaders.clear();
+}
+
+ShaderProgramSource TestShaderCompile::MakeVariant(int index) const {
+  std::string define = "#define VARIANT " + std::to_string(m_Run * 10000 + index);
+  return {AddDefine(m_Source.VertexSource, define),
+          AddDefine(m_Source.FragmentSource, define)};
+}
+
+void TestShaderCompile::RunSerial() {
+  m_Run++;
+  m_Shaders.clear();
+  ShaderOptions options;
+  options.UseCache = false;
+
+  Clock::time_point start = Clock::now();
+  for (int i = 0; i < m_ProgramCount; i++) {
+    m_Shaders.push_back(std::make_unique<Shader>(MakeVariant(i), options));
+  }
+  m_SerialMs = MillisecondsSince(start);
+}
+
+void TestShaderCompile::StartBatched() {
+  m_Run++;
+  m_Shaders.clear();
+  m_Compiler = std::make_unique<ShaderCompiler>();
+  ShaderOptions options;
+  options.UseCache = false;
+  options.Async = true;
+
+  m_BatchStart = Clock::now();
+  for (int i = 0; i < m_ProgramCount; i++) {
+    m_Shaders.push_back(std::make_unique<Shader>(MakeVariant(i), options));
+    m_Compiler->Add(*m_Shaders.back());
+  }
+  m_BatchSubmitMs = MillisecondsSince(m_BatchStart);
+  m_BatchLongestPollMs = 0.0f;
+  m_BatchFrames = 0;
+  m_BatchPending = true;
+}
+
+void TestShaderCompile::OnUpdate(float deltaTime) {
+  if (!m_BatchPending) {
+    return;
+  }
+  Clock::time_point pollStart = Clock::now();
+  unsigned int remaining = m_Compiler->Poll();
+  m_BatchLongestPollMs = std::max(m_BatchLongestPollMs, MillisecondsSince(pollStart));
+  m_BatchFrames++;
+  if (remaining == 0) {
+    m_BatchTotalMs = MillisecondsSince(m_BatchStart);
+    m_BatchPending = false;
+  }
+}
+
+void TestShaderCompile::OnImGuiRender() {
+  ImGui::SliderInt("Programs", &m_ProgramCount, 1, 128);
+  ImGui::Text("GL_KHR_parallel_shader_compile: %s",
+              ShaderCompiler::IsParallelSupported() ? "yes" : "no");
+
+  if (ImGui::Button("Compile serially") && !m_BatchPending) {
+    RunSerial();
+  }
+  ImGui::Text("Serial: %.2f ms blocked in one frame", m_SerialMs);
+
+  if (ImGui::Button("Compile batched") && !m_BatchPending) {
+    StartBatched();
+  }
+  if (m_BatchPending) {
+    ImGui::Text("Batched: compiling... (%d frames)", m_BatchFrames);
+  } else {
+    ImGui::Text("Batched: %.2f ms total over %d frames", m_BatchTotalMs, m_BatchFrames);
+  }
+  ImGui::Text("  submit %.2f ms, longest poll %.2f ms", m_BatchSubmitMs, m_BatchLongestPollMs);
+}
+} // namespace test
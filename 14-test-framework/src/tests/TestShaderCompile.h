@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Test.h"
+
+#include "Shader.h"
+#include "ShaderCompiler.h"
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace test {
+    // Compares building N programs one after another with starting them all
+    // up front and polling for completion once per frame
+    class TestShaderCompile : public Test {
+        public:
+        TestShaderCompile();
+        ~TestShaderCompile();
+
+        void OnUpdate(float deltaTime) override;
+        void OnImGuiRender() override;
+
+      private:
+        using Clock = std::chrono::steady_clock;
+
+        ShaderProgramSource MakeVariant(int index) const;
+        void RunSerial();
+        void StartBatched();
+
+        ShaderProgramSource m_Source;
+        std::unique_ptr<ShaderCompiler> m_Compiler;
+        std::vector<std::unique_ptr<Shader>> m_Shaders;
+        int m_ProgramCount;
+        int m_Run; // Makes every run's sources unique so no cache can help
+
+        float m_SerialMs;
+        bool m_BatchPending;
+        Clock::time_point m_BatchStart;
+        float m_BatchSubmitMs, m_BatchTotalMs, m_BatchLongestPollMs;
+        int m_BatchFrames;
+    };
+    } // namespace test
@@ -10,6 +10,7 @@
 namespace test {
 TestTexture2D::TestTexture2D()
     : m_TranslationA(50, 50, 0), m_TranslationB(600, 50, 0),
+      m_PrevTranslationA(m_TranslationA), m_PrevTranslationB(m_TranslationB),
       m_Proj(glm::ortho(0.0f, 960.0f, 0.0f, 540.0f, -1.0f, 1.0f)),
       m_View(glm::mat4(1.0f)), m_DirectionAx(1), m_DirectionAy(1),
       m_DirectionBx(1), m_DirectionBy(1), m_SpeedA({2, 2}), m_SpeedB({2, 2}) {
@@ -22,8 +23,8 @@ TestTexture2D::TestTexture2D()
   unsigned int indices[] = {0, 1, 2, 2, 3, 0};
 
   // Alpha transparency blending
-  GLCall(glEnable(GL_BLEND));
-  GLCall(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+  GLState::SetBlend(true);
+  GLState::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
   m_VAO = std::make_unique<VertexArray>();
   m_VertexBuffer = std::make_unique<VertexBuffer>(positions, 4 * 4 * sizeof(float));
@@ -38,11 +39,31 @@ TestTexture2D::TestTexture2D()
   m_Shader->Bind();
   m_Texture = std::make_unique<Texture>("res/textures/bowser.png");
   m_Shader->SetUniform1i("u_Texture", 0);
+  m_MVPUniform = m_Shader->GetUniform<glm::mat4>("u_MVP");
 }
 
 TestTexture2D::~TestTexture2D() {}
 
-void TestTexture2D::OnUpdate(float deltaTime) {}
+void TestTexture2D::OnFixedUpdate(float step) {
+  // Speeds are tuned for 60 updates per second
+  float scale = step * 60.0f;
+
+  m_PrevTranslationA = m_TranslationA;
+  if (m_TranslationA.x >= 960 || m_TranslationA.x <= 0)
+    m_DirectionAx *= -1;
+  if (m_TranslationA.y >= 540 || m_TranslationA.y <= 0)
+    m_DirectionAy *= -1;
+  m_TranslationA.x += m_DirectionAx * m_SpeedA[0] * scale;
+  m_TranslationA.y += m_DirectionAy * m_SpeedA[1] * scale;
+
+  m_PrevTranslationB = m_TranslationB;
+  if (m_TranslationB.x >= 960 || m_TranslationB.x <= 0)
+    m_DirectionBx *= -1;
+  if (m_TranslationB.y >= 540 || m_TranslationB.y <= 0)
+    m_DirectionBy *= -1;
+  m_TranslationB.x += m_DirectionBx * m_SpeedB[0] * scale;
+  m_TranslationB.y += m_DirectionBy * m_SpeedB[1] * scale;
+}
 
 void TestTexture2D::OnRender() {
   GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
@@ -51,30 +72,20 @@ void TestTexture2D::OnRender() {
   m_Texture->Bind();
 
   {
-    if (m_TranslationA.x >= 960 || m_TranslationA.x <= 0)
-      m_DirectionAx *= -1;
-    if (m_TranslationA.y >= 540 || m_TranslationA.y <= 0)
-      m_DirectionAy *= -1;
-    m_TranslationA.x += m_DirectionAx * m_SpeedA[0];
-    m_TranslationA.y += m_DirectionAy * m_SpeedA[1];
-    glm::mat4 model = glm::translate(glm::mat4(1.0f), m_TranslationA);
+    glm::vec3 translation = glm::mix(m_PrevTranslationA, m_TranslationA, m_Interpolation);
+    glm::mat4 model = glm::translate(glm::mat4(1.0f), translation);
     glm::mat4 mvp = m_Proj * m_View * model;
     m_Shader->Bind();
-    m_Shader->SetUniformMat4f("u_MVP", mvp);
+    m_Shader->SetUniform(m_MVPUniform, mvp);
     renderer.Draw(*m_VAO, *m_IndexBuffer, *m_Shader);
   }
 
   {
-    if (m_TranslationB.x >= 960 || m_TranslationB.x <= 0)
-      m_DirectionBx *= -1;
-    if (m_TranslationB.y >= 540 || m_TranslationB.y <= 0)
-      m_DirectionBy *= -1;
-    m_TranslationB.x += m_DirectionBx * m_SpeedB[0];
-    m_TranslationB.y += m_DirectionBy * m_SpeedB[1];
-    glm::mat4 model = glm::translate(glm::mat4(1.0f), m_TranslationB);
+    glm::vec3 translation = glm::mix(m_PrevTranslationB, m_TranslationB, m_Interpolation);
+    glm::mat4 model = glm::translate(glm::mat4(1.0f), translation);
     glm::mat4 mvp = m_Proj * m_View * model;
     m_Shader->Bind();
-    m_Shader->SetUniformMat4f("u_MVP", mvp);
+    m_Shader->SetUniform(m_MVPUniform, mvp);
     renderer.Draw(*m_VAO, *m_IndexBuffer, *m_Shader);
   }
 }
@@ -14,7 +14,7 @@ namespace test {
         TestTexture2D();
         ~TestTexture2D();
 
-        void OnUpdate(float deltaTime) override;
+        void OnFixedUpdate(float step) override;
         void OnRender() override;
         void OnImGuiRender() override;
 
@@ -24,9 +24,11 @@ namespace test {
         std::unique_ptr<IndexBuffer> m_IndexBuffer;
         std::unique_ptr<Shader> m_Shader;
         std::unique_ptr<Texture> m_Texture;
+        Uniform<glm::mat4> m_MVPUniform;
         glm::vec3 m_TranslationA, m_TranslationB;
+        glm::vec3 m_PrevTranslationA, m_PrevTranslationB; // Before the last step
         glm::mat4 m_Proj, m_View;
         int m_DirectionAx, m_DirectionAy, m_DirectionBx, m_DirectionBy;
-        int m_SpeedA[2], m_SpeedB[2]; // x, y
+        int m_SpeedA[2], m_SpeedB[2]; // x, y in pixels per 1/60 s
     };
     } // namespace test
\ No newline at end of file
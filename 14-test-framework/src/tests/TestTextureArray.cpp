@@ -0,0 +1,114 @@
+#include "TestTextureArray.h"
+
+#include <cstdlib>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "Renderer.h"
+#include "TestHelpers.h"
+
+#include "imgui/imgui.h"
+
+namespace test {
+TestTextureArray::TestTextureArray()
+    : m_Proj(glm::ortho(0.0f, 960.0f, 0.0f, 540.0f, -1.0f, 1.0f)),
+      m_View(glm::mat4(1.0f)), m_InstanceCount(10000), m_Size(24.0f) {
+  float positions[] = {
+      -0.5f, -0.5f, 0.0f, 0.0f, // bottom left
+       0.5f, -0.5f, 1.0f, 0.0f, // bottom right
+       0.5f,  0.5f, 1.0f, 1.0f, // top right
+      -0.5f,  0.5f, 0.0f, 1.0f  // top left
+  };
+  unsigned int indices[] = {0, 1, 2, 2, 3, 0};
+
+  // Alpha transparency blending
+  GLState::SetBlend(true);
+  GLState::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+  m_VAO = std::make_unique<VertexArray>();
+  m_VertexBuffer = std::make_unique<VertexBuffer>(positions, 4 * 4 * sizeof(float));
+  VertexBufferLayout layout;
+  layout.Push<float>(2); // position
+  layout.Push<float>(2); // texture coordinates
+  m_VAO->AddBuffer(*m_VertexBuffer, layout);
+
+  m_InstanceBuffer = std::make_unique<VertexBuffer>(MaxInstances * sizeof(InstanceData));
+  VertexBufferLayout instanceLayout;
+  instanceLayout.Push<float>(4, 1); // centre, size, layer
+  instanceLayout.Push<float>(4, 1); // tint
+  m_VAO->AddBuffer(*m_InstanceBuffer, instanceLayout);
+
+  m_IndexBuffer = std::make_unique<IndexBuffer>(indices, 6);
+
+  // A generated 64x64 checkerboard per layer, each in its own colour and
+  // square count, so neighbouring layers are easy to tell apart
+  const int size = 64;
+  m_Textures = std::make_unique<TextureArray>(size, size, LayerCount);
+  std::vector<unsigned char> pixels(size * size * 4);
+  for (int layer = 0; layer < m_Textures->GetLayerCount(); layer++) {
+    int squares = 2 << (layer % 4);
+    unsigned char r = std::rand() % 256, g = std::rand() % 256, b = std::rand() % 256;
+    for (int y = 0; y < size; y++) {
+      for (int x = 0; x < size; x++) {
+        bool light = ((x * squares / size) + (y * squares / size)) % 2 == 0;
+        unsigned char *pixel = &pixels[(y * size + x) * 4];
+        pixel[0] = light ? r : r / 4;
+        pixel[1] = light ? g : g / 4;
+        pixel[2] = light ? b : b / 4;
+        pixel[3] = 255;
+      }
+    }
+    m_Textures->SetLayer(layer, pixels.data());
+  }
+
+  m_Shader = std::make_unique<Shader>("res/shaders/TextureArray.shader");
+  m_Shader->Bind();
+  m_Shader->SetUniform1i("u_Textures", 0);
+  m_ViewProjectionUniform = m_Shader->GetUniform<glm::mat4>("u_ViewProjection");
+
+  m_Sprites.resize(MaxInstances);
+  for (Sprite &sprite : m_Sprites) {
+    sprite.Position = {RandomFloat(0.0f, 960.0f), RandomFloat(0.0f, 540.0f)};
+    sprite.Velocity = {RandomFloat(-2.0f, 2.0f), RandomFloat(-2.0f, 2.0f)};
+    sprite.Layer = std::rand() % m_Textures->GetLayerCount();
+  }
+  m_Instances.reserve(MaxInstances);
+}
+
+TestTextureArray::~TestTextureArray() {}
+
+void TestTextureArray::OnFixedUpdate(float step) {
+  for (int i = 0; i < m_InstanceCount; i++) {
+    Sprite &sprite = m_Sprites[i];
+    Bounce(sprite.Position, sprite.Velocity, step);
+  }
+}
+
+void TestTextureArray::OnRender() {
+  GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+  GLCall(glClear(GL_COLOR_BUFFER_BIT));
+  Renderer renderer;
+
+  m_Instances.clear();
+  for (int i = 0; i < m_InstanceCount; i++) {
+    const Sprite &sprite = m_Sprites[i];
+    m_Instances.push_back({glm::vec4(sprite.Position, m_Size, sprite.Layer), glm::vec4(1.0f)});
+  }
+  m_InstanceBuffer->SetData(m_Instances.data(), m_Instances.size() * sizeof(InstanceData));
+
+  // Every layer is reachable through this one bind
+  m_Textures->Bind();
+  m_Shader->Bind();
+  m_Shader->SetUniform(m_ViewProjectionUniform, m_Proj * m_View);
+  renderer.DrawInstanced(*m_VAO, *m_IndexBuffer, *m_Shader, m_InstanceCount);
+}
+
+void TestTextureArray::OnImGuiRender() {
+  ImGui::SliderInt("Instances", &m_InstanceCount, 1, MaxInstances);
+  ImGui::SliderFloat("Size", &m_Size, 4.0f, 128.0f);
+  ImGui::Text("Layers: %d, draw calls: 1", m_Textures->GetLayerCount());
+  ImGui::Text("Application average %.3f ms/frame (%.1f FPS)",
+              1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+}
+} // namespace test
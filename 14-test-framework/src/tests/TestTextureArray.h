@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Test.h"
+
+#include "VertexBuffer.h"
+#include "VertexBufferLayout.h"
+#include "TextureArray.h"
+
+#include <memory>
+#include <vector>
+
+namespace test {
+    class TestTextureArray : public Test {
+        public:
+        TestTextureArray();
+        ~TestTextureArray();
+
+        void OnFixedUpdate(float step) override;
+        void OnRender() override;
+        void OnImGuiRender() override;
+
+      private:
+        // Layout must match the per-instance attributes in TextureArray.shader
+        struct InstanceData {
+            glm::vec4 Sprite; // centre, size, layer
+            glm::vec4 Tint;
+        };
+
+        struct Sprite {
+            glm::vec2 Position;
+            glm::vec2 Velocity; // pixels per 1/60 s
+            float Layer;
+        };
+
+        static const int MaxInstances = 100000;
+        static const int LayerCount = 256;
+
+        std::unique_ptr<VertexArray> m_VAO;
+        std::unique_ptr<VertexBuffer> m_VertexBuffer;
+        std::unique_ptr<VertexBuffer> m_InstanceBuffer;
+        std::unique_ptr<IndexBuffer> m_IndexBuffer;
+        std::unique_ptr<Shader> m_Shader;
+        std::unique_ptr<TextureArray> m_Textures;
+        Uniform<glm::mat4> m_ViewProjectionUniform;
+        std::vector<Sprite> m_Sprites;
+        std::vector<InstanceData> m_Instances;
+        glm::mat4 m_Proj, m_View;
+        int m_InstanceCount;
+        float m_Size;
+    };
+    } // namespace test
@@ -0,0 +1,113 @@
+#include "TestTextureAtlas.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "Renderer.h"
+#include "TestHelpers.h"
+
+#include "imgui/imgui.h"
+
+namespace test {
+TestTextureAtlas::TestTextureAtlas()
+    : m_Proj(glm::ortho(0.0f, 960.0f, 0.0f, 540.0f, -1.0f, 1.0f)),
+      m_View(glm::mat4(1.0f)), m_UseAtlas(true) {
+  // Alpha transparency blending
+  GLState::SetBlend(true);
+  GLState::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+  m_BatchRenderer = std::make_unique<BatchRenderer>();
+
+  // Small generated sprites (rings in random colours and sizes) plus bowser.
+  // AddFile names an image by its path.
+  AtlasBuilder builder(1024);
+  std::vector<std::string> names;
+  const std::string bowser = "res/textures/bowser.png";
+  if (builder.AddFile(bowser)) {
+    names.push_back(bowser);
+    m_Textures.push_back(std::make_unique<Texture>(bowser));
+  } else {
+    std::cout << "Error: atlas test runs without " << bowser << std::endl;
+  }
+  for (int i = 0; i < 63; i++) {
+    int size = 16 + std::rand() % 49;
+    unsigned char r = std::rand() % 256, g = std::rand() % 256, b = std::rand() % 256;
+    std::vector<unsigned char> pixels(size * size * 4);
+    float center = (size - 1) * 0.5f;
+    for (int y = 0; y < size; y++) {
+      for (int x = 0; x < size; x++) {
+        float distance = glm::length(glm::vec2(x - center, y - center)) / center;
+        unsigned char *pixel = &pixels[(y * size + x) * 4];
+        pixel[0] = r;
+        pixel[1] = g;
+        pixel[2] = b;
+        pixel[3] = (distance > 0.5f && distance <= 1.0f) ? 255 : 0;
+      }
+    }
+    names.push_back("ring" + std::to_string(i));
+    builder.Add(names.back(), size, size, pixels.data());
+    m_Textures.push_back(std::make_unique<Texture>(size, size, pixels.data()));
+  }
+
+  AtlasData atlas;
+  if (builder.Build(atlas)) {
+    m_Atlas = std::make_unique<TextureAtlas>(atlas);
+    for (const std::string &name : names)
+      m_Regions.push_back(m_Atlas->Find(name));
+  } else {
+    std::cout << "Error: atlas test could not build its atlas" << std::endl;
+    m_UseAtlas = false;
+  }
+
+  m_Sprites.resize(10000);
+  for (Sprite &sprite : m_Sprites) {
+    sprite.Position = {RandomFloat(0.0f, 960.0f), RandomFloat(0.0f, 540.0f)};
+    sprite.Velocity = {RandomFloat(-2.0f, 2.0f), RandomFloat(-2.0f, 2.0f)};
+    sprite.Image = std::rand() % m_Textures.size();
+  }
+}
+
+TestTextureAtlas::~TestTextureAtlas() {}
+
+void TestTextureAtlas::OnFixedUpdate(float step) {
+  for (Sprite &sprite : m_Sprites) {
+    Bounce(sprite.Position, sprite.Velocity, step);
+  }
+}
+
+void TestTextureAtlas::OnRender() {
+  GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+  GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+  glm::vec2 size(16.0f, 16.0f);
+  m_BatchRenderer->ResetStats();
+  m_BatchRenderer->Begin(m_Proj * m_View);
+  for (const Sprite &sprite : m_Sprites) {
+    if (m_UseAtlas)
+      m_BatchRenderer->DrawQuad(sprite.Position, size, *m_Regions[sprite.Image]);
+    else
+      m_BatchRenderer->DrawQuad(sprite.Position, size, *m_Textures[sprite.Image]);
+  }
+  m_BatchRenderer->End();
+}
+
+void TestTextureAtlas::OnImGuiRender() {
+  if (m_Atlas) {
+    ImGui::Checkbox("Use atlas", &m_UseAtlas);
+    ImGui::Text("%d images, %d atlas page(s)", (int)m_Textures.size(), m_Atlas->GetPageCount());
+  } else {
+    ImGui::Text("%d images, no atlas", (int)m_Textures.size());
+  }
+
+  const BatchRenderer::Stats &stats = m_BatchRenderer->GetStats();
+  ImGui::Text("Draw calls: %u, quads: %u", stats.DrawCalls, stats.QuadCount);
+  if (stats.DroppedQuads)
+    ImGui::Text("Dropped quads (frame full): %u", stats.DroppedQuads);
+  ImGui::Text("Application average %.3f ms/frame (%.1f FPS)",
+              1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+}
+} // namespace test
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Test.h"
+
+#include "BatchRenderer.h"
+#include "TextureAtlas.h"
+
+#include <memory>
+#include <vector>
+
+namespace test {
+    class TestTextureAtlas : public Test {
+        public:
+        TestTextureAtlas();
+        ~TestTextureAtlas();
+
+        void OnFixedUpdate(float step) override;
+        void OnRender() override;
+        void OnImGuiRender() override;
+
+      private:
+        struct Sprite {
+            glm::vec2 Position;
+            glm::vec2 Velocity; // pixels per 1/60 s
+            int Image;
+        };
+
+        std::unique_ptr<BatchRenderer> m_BatchRenderer;
+        // Null if the images did not fit
+        std::unique_ptr<TextureAtlas> m_Atlas;
+        // Each image's region, looked up by name, and the same images as
+        // separate textures for comparison; Sprite::Image indexes both
+        std::vector<const TextureRegion *> m_Regions;
+        std::vector<std::unique_ptr<Texture>> m_Textures;
+        std::vector<Sprite> m_Sprites;
+        glm::mat4 m_Proj, m_View;
+        bool m_UseAtlas;
+    };
+    } // namespace test
@@ -0,0 +1,131 @@
+#include "TestUniformBuffer.h"
+
+#include <cstdlib>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "Renderer.h"
+#include "UniformBlockLayout.h"
+#include "TestHelpers.h"
+
+#include "imgui/imgui.h"
+
+namespace test {
+static const int MaxObjects = 1000;
+
+TestUniformBuffer::TestUniformBuffer()
+    : m_Proj(glm::ortho(0.0f, 960.0f, 0.0f, 540.0f, -1.0f, 1.0f)),
+      m_View(glm::mat4(1.0f)), m_ObjectCount(0) {
+  float positions[] = {
+      -25.0f, -25.0f, 0.0f, 0.0f, // bottom left
+       25.0f, -25.0f, 1.0f, 0.0f, // bottom right
+       25.0f,  25.0f, 1.0f, 1.0f, // top right
+      -25.0f,  25.0f, 0.0f, 1.0f  // top left
+  };
+  unsigned int indices[] = {0, 1, 2, 2, 3, 0};
+
+  // Alpha transparency blending
+  GLState::SetBlend(true);
+  GLState::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+  m_VAO = std::make_unique<VertexArray>();
+  m_VertexBuffer = std::make_unique<VertexBuffer>(positions, 4 * 4 * sizeof(float));
+  VertexBufferLayout layout;
+  layout.Push<float>(2); // position
+  layout.Push<float>(2); // texture coordinates
+  m_VAO->AddBuffer(*m_VertexBuffer, layout);
+  m_IndexBuffer = std::make_unique<IndexBuffer>(indices, 6);
+
+  m_TextureShader = std::make_unique<Shader>("res/shaders/UniformBlock.shader");
+  m_TextureShader->Bind();
+  m_TextureShader->SetUniform1i("u_Texture", 0);
+  m_TextureShader->SetUniformBlockBinding("Camera", CameraBinding);
+  m_TextureShader->SetUniformBlockBinding("Object", ObjectBinding);
+
+  m_ColorShader = std::make_unique<Shader>("res/shaders/UniformBlockColor.shader");
+  m_ColorShader->SetUniformBlockBinding("Camera", CameraBinding);
+  m_ColorShader->SetUniformBlockBinding("Object", ObjectBinding);
+
+  m_Texture = std::make_unique<Texture>("res/textures/bowser.png");
+
+  // Must match the blocks in UniformBlock.shader
+  UniformBlockLayout camera;
+  camera.Push<glm::mat4>(); // u_ViewProjection
+  m_CameraSize = camera.GetSize();
+
+  UniformBlockLayout object;
+  m_ModelOffset = object.Push<glm::mat4>(); // u_Model
+  m_TintOffset = object.Push<glm::vec4>();  // u_Tint
+  m_ObjectSize = object.GetSize();
+
+  // Every block starts on GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, at most 256
+  m_UniformBuffer = std::make_unique<UniformRingBuffer>((MaxObjects + 1) * 256);
+
+  Resize(200);
+}
+
+TestUniformBuffer::~TestUniformBuffer() {}
+
+void TestUniformBuffer::Resize(int count) {
+  int oldCount = m_ObjectCount;
+  m_Objects.resize(count);
+  for (int i = oldCount; i < count; i++) {
+    Object &object = m_Objects[i];
+    object.Position = {RandomFloat(0.0f, 960.0f), RandomFloat(0.0f, 540.0f)};
+    object.Velocity = {RandomFloat(-2.0f, 2.0f), RandomFloat(-2.0f, 2.0f)};
+    object.Tint = {RandomFloat(0.2f, 1.0f), RandomFloat(0.2f, 1.0f),
+                   RandomFloat(0.2f, 1.0f), 1.0f};
+  }
+  m_ObjectCount = count;
+}
+
+void TestUniformBuffer::OnFixedUpdate(float step) {
+  for (Object &object : m_Objects) {
+    Bounce(object.Position, object.Velocity, step);
+  }
+}
+
+void TestUniformBuffer::OnRender() {
+  GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+  GLCall(glClear(GL_COLOR_BUFFER_BIT));
+  Renderer renderer;
+  m_Texture->Bind();
+
+  m_UniformBuffer->BeginFrame();
+
+  UniformRingBuffer::Allocation camera = m_UniformBuffer->Allocate(m_CameraSize);
+  UniformBlockLayout::Write(camera.Data, 0, m_Proj * m_View);
+  m_UniformBuffer->Bind(CameraBinding, camera);
+
+  for (int i = 0; i < m_ObjectCount; i++) {
+    const Object &object = m_Objects[i];
+    UniformRingBuffer::Allocation block = m_UniformBuffer->Allocate(m_ObjectSize);
+    if (!block.Data) {
+      break;
+    }
+    glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(object.Position, 0.0f));
+    UniformBlockLayout::Write(block.Data, m_ModelOffset, model);
+    UniformBlockLayout::Write(block.Data, m_TintOffset, object.Tint);
+    m_UniformBuffer->Bind(ObjectBinding, block);
+
+    // Alternate programs; the camera block stays bound across the switch
+    const Shader &shader = (i % 2) ? *m_ColorShader : *m_TextureShader;
+    renderer.Draw(*m_VAO, *m_IndexBuffer, shader);
+  }
+
+  m_UniformBuffer->EndFrame();
+}
+
+void TestUniformBuffer::OnImGuiRender() {
+  int count = m_ObjectCount;
+  if (ImGui::SliderInt("Objects", &count, 1, MaxObjects)) {
+    Resize(count);
+  }
+  ImGui::Text("Ring buffer: %s", m_UniformBuffer->IsPersistent()
+                                     ? "persistent mapped"
+                                     : "glBufferSubData fallback");
+  ImGui::Text("Application average %.3f ms/frame (%.1f FPS)",
+              1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+}
+} // namespace test
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "Test.h"
+
+#include "VertexBuffer.h"
+#include "VertexBufferLayout.h"
+#include "Texture.h"
+#include "UniformRingBuffer.h"
+
+#include <memory>
+#include <vector>
+
+namespace test {
+    // Two programs share a Camera block written once per frame; per-object
+    // data is written into a ring buffer and bound by offset
+    class TestUniformBuffer : public Test {
+        public:
+        TestUniformBuffer();
+        ~TestUniformBuffer();
+
+        void OnFixedUpdate(float step) override;
+        void OnRender() override;
+        void OnImGuiRender() override;
+
+      private:
+        // Binding points shared by both shaders
+        static const unsigned int CameraBinding = 0;
+        static const unsigned int ObjectBinding = 1;
+
+        struct Object {
+            glm::vec2 Position;
+            glm::vec2 Velocity; // pixels per 1/60 s
+            glm::vec4 Tint;
+        };
+
+        void Resize(int count);
+
+        std::unique_ptr<VertexArray> m_VAO;
+        std::unique_ptr<VertexBuffer> m_VertexBuffer;
+        std::unique_ptr<IndexBuffer> m_IndexBuffer;
+        std::unique_ptr<Shader> m_TextureShader, m_ColorShader;
+        std::unique_ptr<Texture> m_Texture;
+        std::unique_ptr<UniformRingBuffer> m_UniformBuffer;
+        unsigned int m_CameraSize, m_ObjectSize;
+        unsigned int m_ModelOffset, m_TintOffset;
+        std::vector<Object> m_Objects;
+        glm::mat4 m_Proj, m_View;
+        int m_ObjectCount;
+    };
+    } // namespace test
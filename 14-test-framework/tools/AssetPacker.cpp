@@ -0,0 +1,58 @@
+// Offline asset packer: bundles shaders and textures into one memory mapped
+// .pack file. The app mounts res/assets.pack at startup if it exists.
+//
+//   asset-packer [--compress bc1|bc3|bc7] out.pack file...
+//
+// Assets are named after the paths as given on the command line, so run it
+// from the directory the app runs in:
+//
+//   asset-packer res/assets.pack res/shaders/*.shader res/textures/*.png
+//
+// Images are stored decoded (RGBA8) unless --compress is given, in which case
+// they are block compressed with a full mip chain. Note that a compressed
+// texture ignores TextureOptions::Mipmaps since the chain is already baked.
+// .dds and .ktx2 files are stored as they are.
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "AssetPack.h"
+
+int main(int argc, char **argv) {
+  AssetPackWriter writer;
+  bool valid = true;
+  std::vector<std::string> paths;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "--compress" && i + 1 < argc) {
+      std::string name = argv[++i];
+      if (name == "bc1")
+        writer.SetCompression(CompressedImage::BlockFormat::BC1);
+      else if (name == "bc3")
+        writer.SetCompression(CompressedImage::BlockFormat::BC3);
+      else if (name == "bc7")
+        writer.SetCompression(CompressedImage::BlockFormat::BC7);
+      else
+        valid = false;
+    } else {
+      paths.push_back(arg);
+    }
+  }
+  if (!valid || paths.size() < 2) {
+    std::cout << "Usage: " << argv[0] << " [--compress bc1|bc3|bc7] out.pack file..."
+              << std::endl;
+    return -1;
+  }
+
+  for (size_t i = 1; i < paths.size(); i++) {
+    if (!writer.AddFile(paths[i], paths[i]))
+      return -1;
+  }
+  if (!writer.Save(paths[0]))
+    return -1;
+
+  std::cout << "Status: Packed " << paths.size() - 1 << " assets into " << paths[0]
+            << std::endl;
+  return 0;
+}
@@ -0,0 +1,48 @@
+// Offline atlas packer: merges sprite images into .atlas pages for
+// TextureAtlas.
+//
+//   atlas-packer [--page SIZE] [--padding PIXELS] out.atlas image.png...
+//
+// Regions are named after the image paths as given on the command line.
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "AtlasBuilder.h"
+
+int main(int argc, char **argv) {
+  int pageSize = 2048, padding = 1;
+  std::vector<std::string> paths;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "--page" && i + 1 < argc) {
+      pageSize = std::atoi(argv[++i]);
+    } else if (arg == "--padding" && i + 1 < argc) {
+      padding = std::atoi(argv[++i]);
+    } else {
+      paths.push_back(arg);
+    }
+  }
+  if (paths.size() < 2 || pageSize <= 0 || padding < 0) {
+    std::cout << "Usage: " << argv[0]
+              << " [--page SIZE] [--padding PIXELS] out.atlas image.png..." << std::endl;
+    return -1;
+  }
+
+  AtlasBuilder builder(pageSize, padding);
+  for (size_t i = 1; i < paths.size(); i++) {
+    if (!builder.AddFile(paths[i]))
+      return -1;
+  }
+
+  AtlasData atlas;
+  if (!builder.Build(atlas) || !atlas.Save(paths[0]))
+    return -1;
+
+  std::cout << "Status: Packed " << atlas.Regions.size() << " images into "
+            << atlas.Pages.size() << " page(s) of " << pageSize << "x" << pageSize
+            << " in " << paths[0] << std::endl;
+  return 0;
+}
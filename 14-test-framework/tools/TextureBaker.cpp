@@ -0,0 +1,91 @@
+// Offline texture baker: compresses an image and its mip chain into a .dds
+// file that Texture uploads without decoding.
+//
+//   texture-baker [--format bc1|bc3|bc7] [--no-mipmaps] [--kaiser] out.dds image.png
+//
+// BC1 suits opaque images, BC3 and BC7 keep a full alpha channel; BC7 is the
+// slowest to bake and the best looking. Rows are written bottom first, the
+// way Texture expects them.
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "BlockEncoder.h"
+#include "CompressedImage.h"
+#include "Mipmap.h"
+
+#include "stb_image/stb_image.h"
+
+int main(int argc, char **argv) {
+  CompressedImage::BlockFormat format = CompressedImage::BlockFormat::BC7;
+  bool mipmaps = true;
+  Mipmap::Filter filter = Mipmap::Filter::Box;
+  std::vector<std::string> paths;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "--format" && i + 1 < argc) {
+      std::string name = argv[++i];
+      if (name == "bc1")
+        format = CompressedImage::BlockFormat::BC1;
+      else if (name == "bc3")
+        format = CompressedImage::BlockFormat::BC3;
+      else if (name == "bc7")
+        format = CompressedImage::BlockFormat::BC7;
+      else
+        format = CompressedImage::BlockFormat::Unknown;
+    } else if (arg == "--no-mipmaps") {
+      mipmaps = false;
+    } else if (arg == "--kaiser") {
+      filter = Mipmap::Filter::Kaiser;
+    } else {
+      paths.push_back(arg);
+    }
+  }
+  if (paths.size() != 2 || format == CompressedImage::BlockFormat::Unknown) {
+    std::cout << "Usage: " << argv[0]
+              << " [--format bc1|bc3|bc7] [--no-mipmaps] [--kaiser] out.dds image.png"
+              << std::endl;
+    return -1;
+  }
+
+  // Bottom row first, like Texture
+  stbi_set_flip_vertically_on_load(1);
+  int width, height, bpp;
+  unsigned char *pixels = stbi_load(paths[1].c_str(), &width, &height, &bpp, 4);
+  if (!pixels) {
+    std::cout << "Error: failed to load " << paths[1] << ": " << stbi_failure_reason()
+              << std::endl;
+    return -1;
+  }
+
+  auto start = std::chrono::high_resolution_clock::now();
+  CompressedImage image;
+  image.Format = format;
+  image.Levels.push_back({width, height, BlockEncoder::Encode(pixels, width, height, format)});
+  if (mipmaps) {
+    for (const Mipmap::Level &level : Mipmap::BuildChain(pixels, width, height, filter)) {
+      image.Levels.push_back({level.Width, level.Height,
+                              BlockEncoder::Encode(level.Pixels.data(), level.Width,
+                                                   level.Height, format)});
+    }
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+  stbi_image_free(pixels);
+
+  if (!image.SaveDDS(paths[0]))
+    return -1;
+
+  size_t uncompressed = (size_t)width * height * 4;
+  for (size_t i = 1; i < image.Levels.size(); i++)
+    uncompressed += (size_t)image.Levels[i].Width * image.Levels[i].Height * 4;
+  std::cout << "Status: Baked " << paths[1] << " (" << width << "x" << height << ", "
+            << image.Levels.size() << " levels) to "
+            << CompressedImage::GetFormatName(format) << " in " << paths[0] << ": "
+            << image.GetSize() << " bytes, " << (double)uncompressed / image.GetSize()
+            << "x smaller, "
+            << std::chrono::duration<double, std::milli>(end - start).count() << " ms"
+            << std::endl;
+  return 0;
+}